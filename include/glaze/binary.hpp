@@ -6,3 +6,6 @@
 #include "glaze/binary/header.hpp"
 #include "glaze/binary/read.hpp"
 #include "glaze/binary/write.hpp"
+#include "glaze/binary/size.hpp"
+#include "glaze/binary/view.hpp"
+#include "glaze/record/recorder_binary.hpp"
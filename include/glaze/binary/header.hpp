@@ -3,8 +3,11 @@
 
 #pragma once
 
+#include <bit>
 #include <cstdint>
 
+#include "glaze/util/endian.hpp"
+
 namespace glz::detail
 {
    struct header8 final {
@@ -30,4 +33,37 @@ namespace glz::detail
       uint64_t size : 62;
    };
    static_assert(sizeof(header64) == 8);
+   
+   // Binary values are written in native byte order unless opts::little_endian is set, which fixes the wire format
+   // to little endian. On little endian hosts the conversion compiles away.
+   template <auto Opts>
+   inline constexpr bool swap_bytes = Opts.little_endian && std::endian::native == std::endian::big;
+   
+   // converts between native and wire byte order (the conversion is its own inverse)
+   template <auto Opts, class T>
+   inline T wire_order(const T x) noexcept
+   {
+      if constexpr (swap_bytes<Opts>) {
+         return byteswap_value(x);
+      }
+      else {
+         return x;
+      }
+   }
+   
+   // The canonical header layout is the integer (size << 2) | config stored little endian in 1, 2, 4 or 8 bytes, so the
+   // config is always in the low bits of the first byte. Little endian ABIs allocate the bit-fields above the same way,
+   // so only big endian hosts need to build the header explicitly.
+   template <class Header>
+   inline auto canonical_header(const Header h) noexcept
+   {
+      using U = typename unsigned_of_size<sizeof(Header)>::type;
+      const auto value = static_cast<U>((static_cast<U>(h.size) << 2) | h.config);
+      if constexpr (std::endian::native == std::endian::big) {
+         return byteswap(value);
+      }
+      else {
+         return value;
+      }
+   }
 }
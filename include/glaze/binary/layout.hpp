@@ -0,0 +1,157 @@
+// Glaze Library
+// For the license information refer to glaze.hpp
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "glaze/api/xxh64.hpp"
+#include "glaze/core/common.hpp"
+#include "glaze/util/for_each.hpp"
+#include "glaze/util/gorilla.hpp"
+#include "glaze/util/string_view.hpp"
+
+namespace glz
+{
+   namespace detail
+   {
+      enum struct layout_tag : uint64_t {
+         boolean = 1,
+         character,
+         number,
+         enumeration,
+         string,
+         nullable,
+         map,
+         array,
+         object,
+         glaze_array,
+         encoded,
+         variant,
+         other
+      };
+
+      constexpr uint64_t layout_mix(const uint64_t seed, const uint64_t value) noexcept
+      {
+         std::array<char, 8> bytes{};
+         for (size_t i = 0; i < 8; ++i) {
+            bytes[i] = static_cast<char>((value >> (8 * i)) & 0xff);
+         }
+         return xxh64::hash(bytes.data(), bytes.size(), seed);
+      }
+
+      constexpr uint64_t layout_mix(const uint64_t seed, const sv value) noexcept
+      {
+         return xxh64::hash(value.data(), value.size(), seed);
+      }
+
+      constexpr uint64_t layout_mix(const uint64_t seed, const layout_tag tag) noexcept
+      {
+         return layout_mix(seed, static_cast<uint64_t>(tag));
+      }
+
+      // Structural hash of a type as the binary format sees it: member keys in declaration order, and the shape and
+      // width of every value. Type names are not required, so any type that can be written to binary can be hashed.
+      // Optionals hash their payload, pointer like members are not descended into, which keeps self referential types
+      // finite.
+      template <class T>
+      consteval uint64_t layout_hash_impl()
+      {
+         using V = std::decay_t<T>;
+         if constexpr (bool_t<V>) {
+            return layout_mix(0, layout_tag::boolean);
+         }
+         else if constexpr (char_t<V>) {
+            return layout_mix(layout_mix(0, layout_tag::character), sizeof(V));
+         }
+         else if constexpr (num_t<V>) {
+            uint64_t h = layout_mix(0, layout_tag::number);
+            h = layout_mix(h, sizeof(V));
+            return layout_mix(h, uint64_t(std::floating_point<V>) << 1 | uint64_t(std::is_signed_v<V>));
+         }
+         else if constexpr (glaze_enum_t<V>) {
+            return layout_mix(layout_mix(0, layout_tag::enumeration), sizeof(V));
+         }
+         else if constexpr (str_t<V>) {
+            return layout_mix(0, layout_tag::string);
+         }
+         else if constexpr (encoded_t<V>) {
+            uint64_t h = layout_mix(0, layout_tag::encoded);
+            h = layout_mix(h, static_cast<uint64_t>(V::glaze_encoding));
+            return layout_mix(h, layout_hash_impl<typename V::value_type>());
+         }
+         else if constexpr (is_compressed_v<V>) {
+            // same wire format as a gorilla encoded vector
+            uint64_t h = layout_mix(0, layout_tag::encoded);
+            h = layout_mix(h, static_cast<uint64_t>(encoding::gorilla));
+            return layout_mix(h, layout_hash_impl<std::vector<typename V::value_type>>());
+         }
+         else if constexpr (glaze_object_t<V>) {
+            uint64_t h = layout_mix(0, layout_tag::object);
+            constexpr auto N = std::tuple_size_v<meta_t<V>>;
+            h = layout_mix(h, N);
+            for_each<N>([&](auto I) {
+               using item_t = std::decay_t<decltype(glz::tuplet::get<I>(meta_v<V>))>;
+               using mptr_t = std::tuple_element_t<1, item_t>;
+               h = layout_mix(h, sv{glz::tuplet::get<0>(glz::tuplet::get<I>(meta_v<V>))});
+               h = layout_mix(h, layout_hash_impl<member_t<V, mptr_t>>());
+            });
+            return h;
+         }
+         else if constexpr (glaze_array_t<V>) {
+            uint64_t h = layout_mix(0, layout_tag::glaze_array);
+            constexpr auto N = std::tuple_size_v<meta_t<V>>;
+            h = layout_mix(h, N);
+            for_each<N>([&](auto I) {
+               using mptr_t = std::decay_t<decltype(glz::tuplet::get<I>(meta_v<V>))>;
+               h = layout_mix(h, layout_hash_impl<member_t<V, mptr_t>>());
+            });
+            return h;
+         }
+         else if constexpr (map_t<V>) {
+            using pair_type = nano::ranges::range_value_t<V>;
+            uint64_t h = layout_mix(0, layout_tag::map);
+            h = layout_mix(h, layout_hash_impl<typename pair_type::first_type>());
+            return layout_mix(h, layout_hash_impl<typename pair_type::second_type>());
+         }
+         else if constexpr (array_t<V>) {
+            // a static size is not written, so the extent is part of the layout
+            uint64_t h = layout_mix(0, layout_tag::array);
+            if constexpr (has_static_size<V>) {
+               h = layout_mix(layout_mix(h, 1), get_size<V>());
+            }
+            else {
+               h = layout_mix(h, 0);
+            }
+            return layout_mix(h, layout_hash_impl<nano::ranges::range_value_t<V>>());
+         }
+         else if constexpr (is_variant<V>) {
+            uint64_t h = layout_mix(0, layout_tag::variant);
+            constexpr auto N = std::variant_size_v<V>;
+            h = layout_mix(h, N);
+            for_each<N>([&](auto I) { h = layout_mix(h, layout_hash_impl<std::variant_alternative_t<I, V>>()); });
+            return h;
+         }
+         else if constexpr (nullable_t<V>) {
+            uint64_t h = layout_mix(0, layout_tag::nullable);
+            if constexpr (requires { typename V::value_type; }) {
+               return layout_mix(h, layout_hash_impl<typename V::value_type>());
+            }
+            else {
+               return h;
+            }
+         }
+         else {
+            return layout_mix(layout_mix(0, layout_tag::other), sizeof(V));
+         }
+      }
+   }
+
+   /// <summary>
+   /// compile time structural hash of T used to validate trusted layout binary messages
+   /// </summary>
+   template <class T>
+   inline constexpr uint64_t layout_hash_v = detail::layout_hash_impl<T>();
+}
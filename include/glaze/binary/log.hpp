@@ -0,0 +1,390 @@
+// Glaze Library
+// For the license information refer to glaze.hpp
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "glaze/binary/read.hpp"
+#include "glaze/binary/write.hpp"
+#include "glaze/file/mapped_file.hpp"
+#include "glaze/util/crc32.hpp"
+
+// Binary record log file layout:
+// [8 byte magic] [record]... [index entry]... [trailer]
+// record: [uint32 payload size] [uint32 crc32 of time and payload] [int64 time] [binary payload]
+// The index holds the offset of every index_interval-th record and is written with the trailer when the log is closed.
+// A log that was not closed has no trailer, the reader then rebuilds the index from the records that pass their CRC.
+
+namespace glz
+{
+   namespace detail
+   {
+      inline constexpr std::array<char, 8> log_magic{'G', 'L', 'Z', 'L', 'O', 'G', '0', '1'};
+      inline constexpr std::array<char, 8> log_index_magic{'G', 'L', 'Z', 'I', 'D', 'X', '0', '1'};
+
+      struct log_frame
+      {
+         uint32_t size{};
+         uint32_t crc{};
+         int64_t time{};
+      };
+
+      struct log_index_entry
+      {
+         uint64_t record{};
+         uint64_t offset{};
+         int64_t time{};
+      };
+
+      struct log_trailer
+      {
+         uint64_t index_offset{};
+         uint64_t entries{};
+         uint64_t records{};
+         uint64_t interval{};
+         std::array<char, 8> magic{};
+      };
+
+      template <auto Opts>
+      inline log_frame log_wire_order(log_frame f) noexcept
+      {
+         return {wire_order<Opts>(f.size), wire_order<Opts>(f.crc), wire_order<Opts>(f.time)};
+      }
+
+      template <auto Opts>
+      inline log_index_entry log_wire_order(log_index_entry e) noexcept
+      {
+         return {wire_order<Opts>(e.record), wire_order<Opts>(e.offset), wire_order<Opts>(e.time)};
+      }
+
+      template <auto Opts>
+      inline log_trailer log_wire_order(log_trailer t) noexcept
+      {
+         return {wire_order<Opts>(t.index_offset), wire_order<Opts>(t.entries), wire_order<Opts>(t.records),
+                 wire_order<Opts>(t.interval), t.magic};
+      }
+
+      // covers the time as it is on the wire, so that the CRC does not depend on the byte order of the host
+      template <auto Opts>
+      inline uint32_t log_crc(const int64_t time, const char* payload, const size_t n) noexcept
+      {
+         const auto wire = wire_order<Opts>(time);
+         return crc32(payload, n, crc32(&wire, sizeof(wire)));
+      }
+
+      template <auto Opts, class T>
+      inline T load_wire(const char* p) noexcept
+      {
+         T value;
+         std::memcpy(&value, p, sizeof(T));
+         return log_wire_order<Opts>(value);
+      }
+   }
+
+   /// <summary>
+   /// appends binary messages to a file, each framed with its size, a CRC and an optional timestamp
+   /// timestamps must not decrease so that glz::binary_log_reader can seek by time
+   /// </summary>
+   template <opts Opts = opts{.format = binary}>
+   struct binary_log_writer
+   {
+      static_assert(Opts.format == binary, "binary_log_writer requires the binary format");
+
+      explicit binary_log_writer(const std::string& path, const size_t index_interval = 64)
+         : file(path, std::ios::binary | std::ios::trunc), interval(std::max(index_interval, size_t{1}))
+      {
+         if (!file) {
+            throw std::runtime_error("binary_log_writer: could not open " + path);
+         }
+         file.write(detail::log_magic.data(), detail::log_magic.size());
+         offset = detail::log_magic.size();
+      }
+
+      binary_log_writer(const binary_log_writer&) = delete;
+      binary_log_writer& operator=(const binary_log_writer&) = delete;
+
+      ~binary_log_writer()
+      {
+         try {
+            close();
+         }
+         catch (...) {
+         }
+      }
+
+      template <class T>
+      void write(T&& value, const int64_t time = 0)
+      {
+         if (records > 0 && time < last_time) [[unlikely]] {
+            throw std::runtime_error("binary_log_writer: timestamps must not decrease");
+         }
+
+         static constexpr size_t header = sizeof(detail::log_frame);
+         if (buffer.size() < header + 128) {
+            buffer.resize(header + 128);
+         }
+         size_t ix = header;
+         detail::write<binary>::op<Opts>(std::forward<T>(value), ctx, buffer, ix);
+
+         const auto n = ix - header;
+         if (n > (std::numeric_limits<uint32_t>::max)()) [[unlikely]] {
+            throw std::runtime_error("binary_log_writer: record exceeds 4 GB");
+         }
+         const detail::log_frame frame{static_cast<uint32_t>(n),
+                                       detail::log_crc<Opts>(time, buffer.data() + header, n), time};
+         const auto wire = detail::log_wire_order<Opts>(frame);
+         std::memcpy(buffer.data(), &wire, header);
+
+         if (records % interval == 0) {
+            index.push_back({records, offset, time});
+         }
+         file.write(buffer.data(), ix);
+         offset += ix;
+         last_time = time;
+         ++records;
+      }
+
+      void flush() { file.flush(); }
+
+      // writes the index and trailer, called by the destructor
+      void close()
+      {
+         if (!file.is_open()) {
+            return;
+         }
+         for (auto& entry : index) {
+            const auto wire = detail::log_wire_order<Opts>(entry);
+            file.write(reinterpret_cast<const char*>(&wire), sizeof(wire));
+         }
+         const auto trailer = detail::log_wire_order<Opts>(
+            detail::log_trailer{offset, index.size(), records, interval, detail::log_index_magic});
+         file.write(reinterpret_cast<const char*>(&trailer), sizeof(trailer));
+         file.close();
+      }
+
+      size_t size() const noexcept { return records; }
+
+     private:
+      std::ofstream file;
+      size_t interval{};
+      uint64_t offset{};
+      uint64_t records{};
+      int64_t last_time{};
+      std::vector<detail::log_index_entry> index{};
+      std::string buffer{};
+      context ctx{};
+   };
+
+   /// <summary>
+   /// memory mapped reader for files written by glz::binary_log_writer
+   /// records are located through the sparse index, by number in O(1) and by time in O(log n), followed by a walk of at
+   /// most index_interval record headers
+   /// </summary>
+   template <opts Opts = opts{.format = binary}>
+   struct binary_log_reader
+   {
+      static_assert(Opts.format == binary, "binary_log_reader requires the binary format");
+
+      explicit binary_log_reader(const std::string& path) : file(path)
+      {
+         const auto magic_size = detail::log_magic.size();
+         if (file.size() < magic_size ||
+             !std::equal(detail::log_magic.begin(), detail::log_magic.end(), file.data())) {
+            throw std::runtime_error("binary_log_reader: " + path + " is not a binary log");
+         }
+         if (!load_index()) {
+            rebuild_index();
+         }
+      }
+
+      // number of records
+      size_t size() const noexcept { return records; }
+
+      // true if the log was not closed and its index was rebuilt from the records
+      bool recovered() const noexcept { return rebuilt; }
+
+      // binary payload of record n, a view into the mapped file
+      sv record(const size_t n) const
+      {
+         const auto offset = locate(n);
+         const auto frame = frame_at(offset, n);
+         const auto payload = file.data() + offset + sizeof(detail::log_frame);
+         if (detail::log_crc<Opts>(frame.time, payload, frame.size) != frame.crc) [[unlikely]] {
+            throw std::runtime_error("binary_log_reader: corrupt record " + std::to_string(n));
+         }
+         return {payload, frame.size};
+      }
+
+      int64_t time(const size_t n) const { return frame_at(locate(n), n).time; }
+
+      template <class T>
+      void read(T& value, const size_t n) const
+      {
+         decode(value, record(n));
+      }
+
+      template <class T>
+      T read(const size_t n) const
+      {
+         T value{};
+         read(value, n);
+         return value;
+      }
+
+      // index of the first record with a time at or after t, size() if there is none
+      size_t seek_time(const int64_t t) const
+      {
+         if (index.empty()) {
+            return records;
+         }
+         auto it = std::upper_bound(index.begin(), index.end(), t,
+                                    [](const int64_t t, const auto& entry) { return t <= entry.time; });
+         if (it != index.begin()) {
+            --it;
+         }
+         size_t n = it->record;
+         size_t offset = it->offset;
+         for (; n < records; ++n) {
+            const auto frame = frame_at(offset, n);
+            if (frame.time >= t) {
+               break;
+            }
+            offset += sizeof(detail::log_frame) + frame.size;
+         }
+         return n;
+      }
+
+      /// <summary>
+      /// calls f(payload, time) for the records in [first, last), walking the file sequentially
+      /// </summary>
+      template <class F>
+      void replay(const size_t first, size_t last, F&& f) const
+      {
+         last = std::min(last, records);
+         if (first >= last) {
+            return;
+         }
+         size_t offset = locate(first);
+         for (size_t n = first; n < last; ++n) {
+            const auto frame = frame_at(offset, n);
+            const auto payload = file.data() + offset + sizeof(detail::log_frame);
+            if (detail::log_crc<Opts>(frame.time, payload, frame.size) != frame.crc) [[unlikely]] {
+               throw std::runtime_error("binary_log_reader: corrupt record " + std::to_string(n));
+            }
+            f(sv{payload, frame.size}, frame.time);
+            offset += sizeof(detail::log_frame) + frame.size;
+         }
+      }
+
+      template <class T>
+      static void decode(T& value, const sv payload)
+      {
+         context ctx{};
+         auto it = reinterpret_cast<const std::byte*>(payload.data());
+         const auto end = it + payload.size();
+         detail::read<binary>::op<Opts>(value, ctx, it, end);
+      }
+
+     private:
+      mapped_file file;
+      std::vector<detail::log_index_entry> index{};
+      size_t records{};
+      size_t interval{};
+      // end of the records, the start of the index for a closed log
+      size_t records_end{};
+      bool rebuilt{};
+
+      // header of record n at offset, checked to lie with its payload inside the records
+      detail::log_frame frame_at(const size_t offset, const size_t n) const
+      {
+         if (offset > records_end || records_end - offset < sizeof(detail::log_frame)) [[unlikely]] {
+            throw std::runtime_error("binary_log_reader: corrupt record " + std::to_string(n));
+         }
+         const auto frame = detail::load_wire<Opts, detail::log_frame>(file.data() + offset);
+         if (frame.size > records_end - offset - sizeof(detail::log_frame)) [[unlikely]] {
+            throw std::runtime_error("binary_log_reader: corrupt record " + std::to_string(n));
+         }
+         return frame;
+      }
+
+      // offset of record n
+      size_t locate(const size_t n) const
+      {
+         if (n >= records) [[unlikely]] {
+            throw std::runtime_error("binary_log_reader: record " + std::to_string(n) + " out of range");
+         }
+         const auto& entry = index[n / interval];
+         size_t offset = entry.offset;
+         for (size_t i = entry.record; i < n; ++i) {
+            offset += sizeof(detail::log_frame) + frame_at(offset, i).size;
+         }
+         return offset;
+      }
+
+      bool load_index()
+      {
+         static constexpr auto trailer_size = sizeof(detail::log_trailer);
+         static constexpr auto entry_size = sizeof(detail::log_index_entry);
+         if (file.size() < detail::log_magic.size() + trailer_size) {
+            return false;
+         }
+         const auto trailer =
+            detail::load_wire<Opts, detail::log_trailer>(file.data() + file.size() - trailer_size);
+         if (trailer.magic != detail::log_index_magic || trailer.interval == 0 ||
+             trailer.entries > file.size() / entry_size || trailer.index_offset > file.size() ||
+             trailer.index_offset < detail::log_magic.size() ||
+             trailer.index_offset + trailer.entries * entry_size + trailer_size != file.size() ||
+             trailer.entries != (trailer.records + trailer.interval - 1) / trailer.interval) {
+            return false;
+         }
+         // every entry must point at the header of its record, in order and inside the records
+         std::vector<detail::log_index_entry> entries(trailer.entries);
+         for (size_t i = 0; i < entries.size(); ++i) {
+            const auto& entry = entries[i] = detail::load_wire<Opts, detail::log_index_entry>(
+               file.data() + trailer.index_offset + i * entry_size);
+            if (entry.record != i * trailer.interval || entry.offset < detail::log_magic.size() ||
+                entry.offset > trailer.index_offset ||
+                trailer.index_offset - entry.offset < sizeof(detail::log_frame) ||
+                (i > 0 && entry.offset <= entries[i - 1].offset)) {
+               return false;
+            }
+         }
+         index = std::move(entries);
+         records = trailer.records;
+         interval = trailer.interval;
+         records_end = trailer.index_offset;
+         return true;
+      }
+
+      // walks the records from the start, stopping at the first one that is truncated or fails its CRC
+      void rebuild_index()
+      {
+         rebuilt = true;
+         interval = 64;
+         index.clear();
+         records = 0;
+         size_t offset = detail::log_magic.size();
+         while (offset + sizeof(detail::log_frame) <= file.size()) {
+            const auto frame = detail::load_wire<Opts, detail::log_frame>(file.data() + offset);
+            const auto payload = offset + sizeof(detail::log_frame);
+            if (frame.size > file.size() - payload ||
+                detail::log_crc<Opts>(frame.time, file.data() + payload, frame.size) != frame.crc) {
+               break;
+            }
+            if (records % interval == 0) {
+               index.push_back({records, offset, frame.time});
+            }
+            ++records;
+            offset = payload + frame.size;
+         }
+         records_end = offset;
+      }
+   };
+}
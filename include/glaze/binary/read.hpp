@@ -6,8 +6,13 @@
 #include "glaze/core/format.hpp"
 #include "glaze/util/dump.hpp"
 #include "glaze/binary/header.hpp"
+#include "glaze/binary/layout.hpp"
 #include "glaze/core/read.hpp"
 #include "glaze/file/file_ops.hpp"
+#include "glaze/json/json_ptr.hpp"
+#include "glaze/util/gorilla.hpp"
+#include "glaze/util/murmur.hpp"
+#include "glaze/util/varint.hpp"
 
 namespace glz
 {
@@ -20,7 +25,7 @@ namespace glz
       struct read<binary>
       {
          template <auto Opts, class T, is_context Ctx, class It0, class It1>
-         static void op(T&& value, Ctx&& ctx, It0&& it, It1&& end) noexcept {
+         static void op(T&& value, Ctx&& ctx, It0&& it, It1&& end) noexcept(Opts.no_except) {
             from_binary<std::decay_t<T>>::template op<Opts>(std::forward<T>(value), std::forward<Ctx>(ctx), std::forward<It0>(it), std::forward<It1>(end));
          }
       };
@@ -34,6 +39,7 @@ namespace glz
          {
             using V = std::decay_t<T>;
             std::memcpy(&value, &(*it), sizeof(V));
+            value = wire_order<Opts>(value);
             std::advance(it, sizeof(V));
          }
       };
@@ -58,8 +64,30 @@ namespace glz
          }
       };
       
+      template <auto Opts = opts{}>
       inline constexpr size_t int_from_header(auto&& it, auto&& /*end*/) noexcept
       {
+         if constexpr (swap_bytes<Opts>) {
+            // the canonical header is a little endian integer with the config in the low two bits
+            const auto config = static_cast<uint8_t>(*it) & 3;
+            const auto read = [&]<class U>(U) -> size_t {
+               U x;
+               std::memcpy(&x, &(*it), sizeof(U));
+               std::advance(it, sizeof(U));
+               return static_cast<size_t>(byteswap(x) >> 2);
+            };
+            switch (config) {
+               case 0:
+                  return read(uint8_t{});
+               case 1:
+                  return read(uint16_t{});
+               case 2:
+                  return read(uint32_t{});
+               default:
+                  return read(uint64_t{});
+            }
+         }
+         
          header8 h8;
          std::memcpy(&h8, &(*it), 1);
          switch (h8.config) {
@@ -93,15 +121,50 @@ namespace glz
          }
       }
       
+      // string views and spans over const numbers point into the input buffer instead of copying
+      template <class T>
+      concept string_view_t = is_specialization_v<std::decay_t<T>, std::basic_string_view>;
+
+      template <class T>
+      concept span_view_t = is_span<T> && is_dynamic_span<T> && std::is_const_v<typename T::element_type> &&
+                            (num_t<typename T::element_type> || char_t<typename T::element_type>);
+
+      template <auto Opts = opts{}>
+      inline uint32_t read_u32(auto&& it) noexcept
+      {
+         uint32_t v;
+         std::memcpy(&v, &(*it), 4);
+         return wire_order<Opts>(v);
+      }
+
+      // offset table blocks start with their byte size, the values follow n entries of Stride bytes
+      template <size_t Stride>
+      inline void skip_offset_table(auto&& it, const size_t n) noexcept
+      {
+         std::advance(it, 4 + Stride * n);
+      }
+
+      inline void skip_padding(auto&& it) noexcept
+      {
+         const auto pad = static_cast<uint8_t>(*it);
+         std::advance(it, 1 + pad);
+      }
+
       template <str_t T>
       struct from_binary<T> final
       {
          template <auto Opts>
          static void op(auto&& value, is_context auto&& ctx, auto&& it, auto&& end) noexcept
          {
-            const auto n = int_from_header(it, end);
+            const auto n = int_from_header<Opts>(it, end);
             using V = typename std::decay_t<T>::value_type;
-            if constexpr (sizeof(V) == 1) {
+            if constexpr (string_view_t<T>) {
+               static_assert(!swap_bytes<Opts> || sizeof(V) == 1,
+                             "wide string views cannot be byte swapped, read into a string instead");
+               value = std::decay_t<T>{reinterpret_cast<const V*>(&(*it)), n};
+               std::advance(it, sizeof(V) * n);
+            }
+            else if constexpr (sizeof(V) == 1) {
                value.resize(n);
                std::memcpy(value.data(), &(*it), n);
                std::advance(it, n);
@@ -110,6 +173,9 @@ namespace glz
                const auto n_bytes = sizeof(V) * n;
                value.resize(n);
                std::memcpy(value.data(), &(*it), n_bytes);
+               if constexpr (swap_bytes<Opts>) {
+                  byteswap_array(value.data(), n);
+               }
                std::advance(it, n_bytes);
             }
          }
@@ -119,15 +185,70 @@ namespace glz
       struct from_binary<T> final
       {
          template <auto Opts>
-         static void op(auto&& value, is_context auto&& ctx, auto&& it, auto&& end) noexcept
+         static void op(auto&& value, is_context auto&& ctx, auto&& it, auto&& end) noexcept(Opts.no_except)
          {
-            if constexpr (has_static_size<T>) {
+            if constexpr (contiguous_num_t<T>) {
+               using V = std::decay_t<nano::ranges::range_value_t<T>>;
+               size_t n{};
+               if constexpr (has_static_size<T>) {
+                  n = get_size<T>();
+               }
+               else {
+                  n = int_from_header<Opts>(it, end);
+               }
+               if constexpr (Opts.aligned_arrays && alignof(V) > 1) {
+                  skip_padding(it);
+               }
+
+               const auto n_bytes = sizeof(V) * n;
+               if constexpr (span_view_t<T>) {
+                  static_assert(!swap_bytes<Opts> || sizeof(V) == 1,
+                                "span views cannot be byte swapped, read into a vector instead");
+                  const auto data = reinterpret_cast<const V*>(&(*it));
+                  if (reinterpret_cast<uintptr_t>(data) % alignof(V) != 0) [[unlikely]] {
+                     if constexpr (Opts.no_except) {
+                        value = {};
+                        std::advance(it, n_bytes);
+                        return;
+                     }
+                     else {
+                        throw std::runtime_error("misaligned binary span, write with aligned_arrays");
+                     }
+                  }
+                  value = std::decay_t<T>{data, n};
+               }
+               else {
+                  if constexpr (resizeable<T>) {
+                     value.resize(n);
+                  }
+                  const auto n_read = std::min(n, size_t(value.size()));
+                  if (n_read) {
+                     std::memcpy(value.data(), &(*it), sizeof(V) * n_read);
+                     if constexpr (swap_bytes<Opts>) {
+                        byteswap_array(value.data(), n_read);
+                     }
+                  }
+               }
+               std::advance(it, n_bytes);
+            }
+            else if constexpr (has_static_size<T>) {
+               const auto block = it;
+               if constexpr (Opts.offset_table) {
+                  skip_offset_table<4>(it, get_size<T>());
+               }
                for (auto&& item : value) {
                   read<binary>::op<Opts>(item, ctx, it, end);
                }
+               if constexpr (Opts.offset_table) {
+                  it = std::next(block, read_u32<Opts>(block));
+               }
             }
             else {
-               const auto n = int_from_header(it, end);
+               const auto n = int_from_header<Opts>(it, end);
+               const auto block = it;
+               if constexpr (Opts.offset_table) {
+                  skip_offset_table<4>(it, n);
+               }
 
                if constexpr (resizeable<T>) {
                   value.resize(n);
@@ -136,6 +257,9 @@ namespace glz
                for (auto&& item: value) {
                   read<binary>::op<Opts>(item, ctx, it, end);
                }
+               if constexpr (Opts.offset_table) {
+                  it = std::next(block, read_u32<Opts>(block));
+               }
             }
          }
       };
@@ -144,9 +268,13 @@ namespace glz
       struct from_binary<T> final
       {
          template <auto Opts>
-         static void op(auto&& value, is_context auto&& ctx, auto&& it, auto&& end) noexcept
+         static void op(auto&& value, is_context auto&& ctx, auto&& it, auto&& end) noexcept(Opts.no_except)
          {
-            const auto n = int_from_header(it, end);
+            const auto n = int_from_header<Opts>(it, end);
+            const auto block = it;
+            if constexpr (Opts.offset_table) {
+               skip_offset_table<4>(it, n);
+            }
             
             if constexpr (std::is_arithmetic_v<std::decay_t<typename T::key_type>>) {
                typename T::key_type key;
@@ -162,6 +290,9 @@ namespace glz
                   read<binary>::op<Opts>(value[key], ctx, it, end);
                }
             }
+            if constexpr (Opts.offset_table) {
+               it = std::next(block, read_u32<Opts>(block));
+            }
          };
       };
 
@@ -169,7 +300,7 @@ namespace glz
       struct from_binary<T> final
       {
          template <auto Opts>
-         static void op(auto&& value, is_context auto&& ctx, auto&& it, auto&& end) noexcept
+         static void op(auto&& value, is_context auto&& ctx, auto&& it, auto&& end) noexcept(Opts.no_except)
          {
             const auto has_value = static_cast<bool>(*it);
             ++it;
@@ -195,6 +326,162 @@ namespace glz
          }
       };
       
+      // Reports input that cannot be decoded: throws, or with no_except skips the rest of the input.
+      // Also used by read_partial, which stops at the end of the input.
+      template <auto Opts>
+      void encoded_error(const char* message, auto&& it, auto&& end) noexcept(Opts.no_except)
+      {
+         if constexpr (Opts.no_except) {
+            (void)message;
+            std::advance(it, std::distance(it, end));
+         }
+         else {
+            throw std::runtime_error(message);
+         }
+      }
+
+      // reads a stream written by dump_gorilla, returning the value count
+      // every value after the first takes at least one bit, which bounds the count by the input size, the values
+      // themselves are checked against the bit count by the decoder
+      template <auto Opts>
+      size_t read_gorilla(auto&& it, auto&& end, size_t& bits, std::vector<uint64_t>& words) noexcept(Opts.no_except)
+      {
+         const auto n = int_from_header<Opts>(it, end);
+         bits = int_from_header<Opts>(it, end);
+         const auto available = size_t(std::distance(it, end));
+         if (bits > available * 8 || (bits + 63) / 64 * sizeof(uint64_t) > available || n > bits) [[unlikely]] {
+            bits = 0;
+            words.clear();
+            encoded_error<Opts>("binary: truncated gorilla stream", it, end);
+            return 0;
+         }
+         words.resize((bits + 63) / 64);
+         if (words.size()) {
+            std::memcpy(words.data(), &(*it), words.size() * sizeof(uint64_t));
+            if constexpr (swap_bytes<Opts>) {
+               byteswap_array(words.data(), words.size());
+            }
+            std::advance(it, words.size() * sizeof(uint64_t));
+         }
+         return n;
+      }
+
+      template <class T>
+      struct from_binary<compressed<T>> final
+      {
+         template <auto Opts>
+         static void op(auto&& value, is_context auto&&, auto&& it, auto&& end) noexcept(Opts.no_except)
+         {
+            size_t bits{};
+            std::vector<uint64_t> words{};
+            const auto n = read_gorilla<Opts>(it, end, bits, words);
+            if (!value.assign(std::move(words), bits, n)) [[unlikely]] {
+               encoded_error<Opts>("binary: corrupt gorilla stream", it, end);
+            }
+         }
+      };
+
+      template <encoding E, class T>
+      struct from_binary<encoded<E, T>> final
+      {
+         template <auto Opts>
+         static void op(auto&& value, is_context auto&& ctx, auto&& it, auto&& end) noexcept(Opts.no_except)
+         {
+            auto& v = value.value;
+            if constexpr (E == encoding::none) {
+               read<binary>::op<Opts>(v, ctx, it, end);
+            }
+            else if constexpr (E == encoding::gorilla) {
+               using I = std::decay_t<nano::ranges::range_value_t<std::decay_t<T>>>;
+               size_t bits{};
+               static thread_local std::vector<uint64_t> words{};
+               const auto n = read_gorilla<Opts>(it, end, bits, words);
+               v.resize(n);
+               bit_reader reader{words.data(), bits};
+               gorilla_state<I> state{};
+               for (auto& x : v) {
+                  x = state.decode(reader);
+               }
+               if (reader.failed) [[unlikely]] {
+                  v.resize(0);
+                  encoded_error<Opts>("binary: corrupt gorilla stream", it, end);
+               }
+            }
+            else {
+               using I = std::decay_t<nano::ranges::range_value_t<std::decay_t<T>>>;
+               static_assert(int_t<I>, "compact encodings require an array of integers");
+               const auto n = int_from_header<Opts>(it, end);
+
+               const auto first = reinterpret_cast<const uint8_t*>(&(*it));
+               const auto last = first + std::distance(it, end);
+               const uint8_t* p = first;
+
+               auto fail = [&](const char* message) {
+                  v.resize(0);
+                  encoded_error<Opts>(message, it, end);
+               };
+
+               if constexpr (E == encoding::rle) {
+                  // the runs must add up to n before anything is allocated, a run takes at least two bytes
+                  size_t described = 0;
+                  for (const uint8_t* q = first; described < n;) {
+                     if (last - q < 2) [[unlikely]] {
+                        return fail("binary: truncated rle array");
+                     }
+                     uint64_t x, count;
+                     q = decode_varint(q, last, x);
+                     q = decode_varint(q, last, count);
+                     described += size_t(std::min(count, uint64_t(n - described)));
+                  }
+               }
+               else if (n > size_t(last - first)) [[unlikely]] {
+                  // every value takes at least one byte
+                  return fail("binary: truncated varint array");
+               }
+
+               v.resize(n);
+               if (n == 0) {
+                  return;
+               }
+               auto out = v.begin();
+               size_t decoded = 0;
+
+               if constexpr (E == encoding::varint) {
+                  p = decode_varints(p, last, n, [&](const uint64_t x) {
+                     *out = from_varint<I>(x);
+                     ++out;
+                     ++decoded;
+                  });
+               }
+               else if constexpr (E == encoding::delta) {
+                  uint64_t prev{};
+                  p = decode_varints(p, last, n, [&](const uint64_t x) {
+                     prev += static_cast<uint64_t>(zigzag_decode(x));
+                     *out = static_cast<I>(prev);
+                     ++out;
+                     ++decoded;
+                  });
+               }
+               else if constexpr (E == encoding::rle) {
+                  while (decoded < n && p < last) {
+                     uint64_t x, count;
+                     p = decode_varint(p, last, x);
+                     p = decode_varint(p, last, count);
+                     count = std::min(count, uint64_t(n - decoded));
+                     out = std::fill_n(out, count, from_varint<I>(x));
+                     decoded += count;
+                  }
+               }
+
+               // a value cut off at the end of the input leaves its continuation bit set
+               if (decoded < n || (p == last && p != first && (*(p - 1) & 0x80))) [[unlikely]] {
+                  return fail("binary: truncated encoded array");
+               }
+               std::advance(it, p - first);
+            }
+         }
+      };
+
       template <class T>
       struct from_binary<includer<T>>
       {
@@ -208,19 +495,73 @@ namespace glz
       struct from_binary<T> final
       {
          template <auto Opts>
-         static void op(auto&& value, is_context auto&& ctx, auto&& it, auto&& end) noexcept
+         static void op(auto&& value, is_context auto&& ctx, auto&& it, auto&& end) noexcept(Opts.no_except)
          {
-            const auto n_keys = int_from_header(it, end);
+            using V = std::decay_t<T>;
+            static constexpr auto N = std::tuple_size_v<meta_t<V>>;
+
+            if constexpr (Opts.positional) {
+               for_each<N>([&](auto I) {
+                  static constexpr auto item = glz::tuplet::get<I>(meta_v<V>);
+                  read<binary>::op<Opts>(get_member(value, glz::tuplet::get<1>(item)), ctx, it, end);
+               });
+               return;
+            }
+            else if constexpr (Opts.trusted_layout) {
+               // verify the layout hash once, anything else is read as a keyed message
+               if (std::distance(it, end) >= 8) {
+                  uint64_t h;
+                  std::memcpy(&h, &(*it), 8);
+                  if (wire_order<Opts>(h) == layout_hash_v<V>) {
+                     std::advance(it, 8);
+                     op<positional<Opts>()>(value, ctx, it, end);
+                     return;
+                  }
+               }
+               op<keyed<Opts>()>(value, ctx, it, end);
+               return;
+            }
+            else if constexpr (Opts.offset_table) {
+               const auto n_keys = int_from_header<Opts>(it, end);
+               const auto block = it;
+               static constexpr auto storage = detail::make_crusher_map<T>();
+               for (size_t i = 0; i < n_keys; ++i) {
+                  const auto entry = std::next(block, 4 + 8 * i);
+                  const auto p = storage.find(read_u32<Opts>(entry));
+                  if (p != storage.end()) {
+                     auto value_it = std::next(block, read_u32<Opts>(std::next(entry, 4)));
+                     std::visit(
+                        [&](auto&& member_ptr) {
+                           read<binary>::op<Opts>(get_member(value, member_ptr), ctx, value_it, end);
+                        },
+                        p->second);
+                  }
+               }
+               it = std::next(block, read_u32<Opts>(block));
+               return;
+            }
+
+            const auto n_keys = int_from_header<Opts>(it, end);
             
             static constexpr auto storage = detail::make_crusher_map<T>();
             
             for (size_t i = 0; i < n_keys; ++i) {
                uint32_t key;
                std::memcpy(&key, &(*it), 4);
+               key = wire_order<Opts>(key);
                std::advance(it, 4);
                
                const auto& p = storage.find(key);
                
+               if constexpr (Opts.length_prefixed) {
+                  const auto n = int_from_header<Opts>(it, end);
+                  if (p == storage.end()) {
+                     // unknown members are jumped over without decoding
+                     std::advance(it, n);
+                     continue;
+                  }
+               }
+               
                if (p != storage.end()) {
                   std::visit(
                              [&](auto&& member_ptr) {
@@ -238,24 +579,146 @@ namespace glz
       struct from_binary<T> final
       {
          template <auto Opts>
-         static void op(auto&& value, is_context auto&& ctx, auto&& it, auto&& end) noexcept
+         static void op(auto&& value, is_context auto&& ctx, auto&& it, auto&& end) noexcept(Opts.no_except)
          {
             using V = std::decay_t<T>;
-            for_each<std::tuple_size_v<meta_t<V>>>([&](auto I) {
+            static constexpr auto N = std::tuple_size_v<meta_t<V>>;
+            const auto block = it;
+            if constexpr (Opts.offset_table) {
+               skip_offset_table<4>(it, N);
+            }
+            for_each<N>([&](auto I) {
                read<binary>::op<Opts>(value.*glz::tuplet::get<I>(meta_v<V>), ctx, it, end);
             });
+            if constexpr (Opts.offset_table) {
+               it = std::next(block, read_u32<Opts>(block));
+            }
          }
       };
    }
    
+   namespace detail
+   {
+      // Reads a message written by write<Partial>. The members arrive in the compile time order the writer used, so
+      // each key is checked against its expected hash and decoded straight into the addressed member, no lookup needed.
+      // A mismatch throws, or with no_except skips the rest of the input and leaves the remaining members untouched.
+      template <auto& Partial, auto Opts, class T>
+      void read_partial(T&& value, is_context auto&& ctx, auto&& it, auto&& end) noexcept(Opts.no_except)
+      {
+         static constexpr auto partial = Partial;  // MSVC 16.11 hack
+
+         if constexpr (nano::ranges::count(partial, "") > 0) {
+            read<binary>::op<Opts>(value, ctx, it, end);
+         }
+         else {
+            static_assert(glaze_object_t<std::decay_t<T>> || map_t<std::decay_t<T>>,
+                          "Only object types are supported for partial.");
+            static constexpr auto sorted = sort_json_ptrs(partial);
+            static constexpr auto groups = glz::group_json_ptrs<sorted>();
+            static constexpr auto N = std::tuple_size_v<std::decay_t<decltype(groups)>>;
+
+            if (it == end || int_from_header<Opts>(it, end) != N) [[unlikely]] {
+               encoded_error<Opts>("partial message does not match the requested members", it, end);
+               return;
+            }
+
+            if constexpr (glaze_object_t<std::decay_t<T>>) {
+               glz::for_each<N>([&](auto I) {
+                  static constexpr auto group = [] {
+                     return glz::tuplet::get<decltype(I)::value>(groups);
+                  }();  // MSVC internal compiler error workaround
+
+                  static constexpr auto key = std::get<0>(group);
+                  static constexpr auto sub_partial = std::get<1>(group);
+                  static constexpr auto frozen_map = make_map<std::decay_t<T>>();
+                  static constexpr auto member_it = frozen_map.find(key);
+                  static_assert(member_it != frozen_map.end(), "Invalid key passed to partial read");
+                  static constexpr auto ix = member_it->second.index();
+                  static constexpr decltype(auto) member_ptr = std::get<ix>(member_it->second);
+
+                  static constexpr uint32_t hash = murmur3_32(key);
+                  if (std::distance(it, end) < 4 || read_u32<Opts>(it) != hash) [[unlikely]] {
+                     encoded_error<Opts>("partial message does not match the requested members", it, end);
+                     return;
+                  }
+                  std::advance(it, 4);
+                  if constexpr (Opts.length_prefixed) {
+                     int_from_header<Opts>(it, end);
+                  }
+                  read_partial<sub_partial, Opts>(get_member(value, member_ptr), ctx, it, end);
+               });
+            }
+            else {
+               glz::for_each<N>([&](auto I) {
+                  static constexpr auto group = [] {
+                     return glz::tuplet::get<decltype(I)::value>(groups);
+                  }();  // MSVC internal compiler error workaround
+                  static constexpr auto key_value = std::get<0>(group);
+                  static constexpr auto sub_partial = std::get<1>(group);
+                  static thread_local auto key = typename std::decay_t<T>::key_type(key_value);
+                  static thread_local typename std::decay_t<T>::key_type read_key{};
+                  if (it == end) [[unlikely]] {
+                     encoded_error<Opts>("partial message does not match the requested members", it, end);
+                     return;
+                  }
+                  read<binary>::op<Opts>(read_key, ctx, it, end);
+                  if (read_key != key) [[unlikely]] {
+                     encoded_error<Opts>("partial message does not match the requested members", it, end);
+                     return;
+                  }
+                  read_partial<sub_partial, Opts>(value[key], ctx, it, end);
+               });
+            }
+         }
+      }
+   }
+
+   /// <summary>
+   /// read a message written with write<Partial> using the same json pointers, only the addressed members are touched
+   /// with no_except a message that does not match is skipped instead of throwing
+   /// </summary>
+   template <auto& Partial, opts Opts, class T, class Buffer>
+   inline void read(T&& value, Buffer&& buffer, is_context auto&& ctx) noexcept(Opts.no_except)
+   {
+      auto b = std::ranges::begin(buffer);
+      auto e = std::ranges::end(buffer);
+      if constexpr (Opts.no_except) {
+         detail::read_partial<Partial, Opts>(value, ctx, b, e);
+      }
+      else {
+         if (b == e) {
+            throw std::runtime_error("No input provided to read");
+         }
+         try {
+            detail::read_partial<Partial, Opts>(value, ctx, b, e);
+         }
+         catch (const std::exception& e) {
+            throw std::runtime_error("read error:" + std::string(e.what()));
+         }
+      }
+   }
+
+   template <auto& Partial, opts Opts, class T, class Buffer>
+   inline void read(T&& value, Buffer&& buffer) noexcept(Opts.no_except)
+   {
+      context ctx{};
+      read<Partial, Opts>(std::forward<T>(value), std::forward<Buffer>(buffer), ctx);
+   }
+
+   template <auto& Partial, class T, class Buffer>
+   inline void read_binary(T&& value, Buffer&& buffer)
+   {
+      read<Partial, opts{.format = binary}>(std::forward<T>(value), std::forward<Buffer>(buffer));
+   }
+
    template <class T, class Buffer>
-   inline void read_binary(T&& value, Buffer&& buffer) noexcept
+   inline void read_binary(T&& value, Buffer&& buffer)
    {
       read<opts{.format = binary}>(value, std::forward<Buffer>(buffer));
    }
    
    template <class T, class Buffer>
-   inline auto read_binary(Buffer&& buffer) noexcept
+   inline auto read_binary(Buffer&& buffer)
    {
       T value{};
       read<opts{.format = binary}>(value, std::forward<Buffer>(buffer));
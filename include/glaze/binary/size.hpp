@@ -0,0 +1,342 @@
+// Glaze Library
+// For the license information refer to glaze.hpp
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <limits>
+
+#include "glaze/binary/write.hpp"
+
+namespace glz
+{
+   namespace detail
+   {
+      inline constexpr size_t dynamic_size = (std::numeric_limits<size_t>::max)();
+
+      // bytes used by the compressed integer header written by dump_int
+      inline constexpr size_t header_size(const size_t n) noexcept
+      {
+         if (n < 64) {
+            return 1;
+         }
+         else if (n < 16384) {
+            return 2;
+         }
+         else if (n < 1073741824) {
+            return 4;
+         }
+         return 8;
+      }
+
+      inline constexpr size_t varint_size(const uint64_t x) noexcept
+      {
+         return x ? (std::bit_width(x) + 6) / 7 : 1;
+      }
+
+      // type of the I-th member of a glaze object or array
+      template <class V, size_t I>
+      struct meta_member
+      {
+         using item_t = std::decay_t<decltype(glz::tuplet::get<I>(meta_v<V>))>;
+         using type = member_t<V, item_t>;
+      };
+
+      template <class V, size_t I>
+      requires glaze_object_t<V>
+      struct meta_member<V, I>
+      {
+         using item_t = std::decay_t<decltype(glz::tuplet::get<I>(meta_v<V>))>;
+         using type = member_t<V, std::tuple_element_t<1, item_t>>;
+      };
+
+      template <class V, size_t I>
+      using meta_member_t = typename meta_member<V, I>::type;
+
+      // Binary size of T when it does not depend on the value, dynamic_size otherwise
+      template <auto Opts, class T>
+      consteval size_t fixed_binary_size()
+      {
+         using V = std::decay_t<T>;
+         if constexpr (bool_t<V>) {
+            return 1;
+         }
+         else if constexpr (num_t<V> || char_t<V> || glaze_enum_t<V>) {
+            return sizeof(V);
+         }
+         else if constexpr (glaze_object_t<V> || glaze_array_t<V>) {
+            constexpr auto N = std::tuple_size_v<meta_t<V>>;
+            constexpr bool object = glaze_object_t<V>;
+            constexpr bool keyed = object && !(Opts.trusted_layout || Opts.positional);
+            constexpr auto member_opts = (object && !keyed) ? positional<Opts>() : Opts;
+            size_t n = 0;
+            if constexpr (object && Opts.trusted_layout && !Opts.positional) {
+               n += 8;
+            }
+            if constexpr (keyed) {
+               n += header_size(N);
+            }
+            if constexpr (Opts.offset_table && (keyed || !object)) {
+               n += 4 + (keyed ? 8 : 4) * N;
+            }
+            bool fixed = true;
+            for_each<N>([&](auto I) {
+               constexpr auto m = fixed_binary_size<member_opts, meta_member_t<V, I>>();
+               if (m == dynamic_size) {
+                  fixed = false;
+                  return;
+               }
+               n += m;
+               if constexpr (keyed && !Opts.offset_table) {
+                  n += 4;
+                  if constexpr (Opts.length_prefixed) {
+                     n += Opts.aligned_arrays ? 4 : header_size(m);
+                  }
+               }
+            });
+            return fixed ? n : dynamic_size;
+         }
+         else if constexpr (array_t<V> && has_static_size<V>) {
+            using E = std::decay_t<nano::ranges::range_value_t<V>>;
+            constexpr auto N = get_size<V>();
+            if constexpr (contiguous_num_t<V> && Opts.aligned_arrays && alignof(E) > 1) {
+               return dynamic_size; // padding depends on the position in the buffer
+            }
+            else if constexpr (contiguous_num_t<V>) {
+               return sizeof(E) * N;
+            }
+            else {
+               constexpr auto e = fixed_binary_size<Opts, E>();
+               if constexpr (e == dynamic_size) {
+                  return dynamic_size;
+               }
+               else {
+                  return (Opts.offset_table ? 4 + 4 * N : 0) + e * N;
+               }
+            }
+         }
+         else {
+            return dynamic_size;
+         }
+      }
+
+      // Write position and high water mark of a dry run. The writer temporarily reserves space for offset tables,
+      // length headers and varint encodings, so the high water mark can exceed the final size.
+      struct size_count
+      {
+         size_t pos{};
+         size_t peak{};
+
+         void add(const size_t n) noexcept
+         {
+            pos += n;
+            peak = (std::max)(peak, pos);
+         }
+
+         void reach(const size_t n) noexcept { peak = (std::max)(peak, n); }
+      };
+
+      // mirrors to_binary, counting bytes instead of writing them
+      template <auto Opts, class T>
+      void binary_size(T&& value, is_context auto&& ctx, size_count& count)
+      {
+         using V = std::decay_t<T>;
+         if constexpr (constexpr auto fixed = fixed_binary_size<Opts, V>(); fixed != dynamic_size) {
+            count.add(fixed);
+         }
+         else if constexpr (is_specialization_v<V, includer> || func_t<V>) {
+         }
+         else if constexpr (str_t<V>) {
+            using C = std::decay_t<decltype(*value.data())>;
+            count.add(header_size(value.size()) + sizeof(C) * value.size());
+         }
+         else if constexpr (is_compressed_v<V>) {
+            count.add(header_size(value.size()) + header_size(value.bit_size()) +
+                      sizeof(uint64_t) * value.words().size());
+         }
+         else if constexpr (encoded_t<V>) {
+            auto& v = value.value;
+            if constexpr (V::glaze_encoding == encoding::none) {
+               binary_size<Opts>(v, ctx, count);
+            }
+            else if constexpr (V::glaze_encoding == encoding::gorilla) {
+               using I = std::decay_t<nano::ranges::range_value_t<std::decay_t<decltype(v)>>>;
+               compressed<I> stream{};
+               for (auto&& x : v) {
+                  stream.push_back(x);
+               }
+               binary_size<Opts>(stream, ctx, count);
+            }
+            else {
+               using I = std::decay_t<nano::ranges::range_value_t<std::decay_t<decltype(v)>>>;
+               const size_t n = v.size();
+               count.add(header_size(n));
+               count.reach(count.pos + max_varint_bytes * (V::glaze_encoding == encoding::rle ? 2 * n : n));
+               size_t bytes = 0;
+               if constexpr (V::glaze_encoding == encoding::varint) {
+                  for (auto&& x : v) {
+                     bytes += varint_size(to_varint<I>(x));
+                  }
+               }
+               else if constexpr (V::glaze_encoding == encoding::delta) {
+                  uint64_t prev{};
+                  for (auto&& x : v) {
+                     const auto current = static_cast<uint64_t>(x);
+                     bytes += varint_size(zigzag_encode(static_cast<int64_t>(current - prev)));
+                     prev = current;
+                  }
+               }
+               else {
+                  auto it = v.begin();
+                  const auto last = v.end();
+                  while (it != last) {
+                     const I x = *it;
+                     uint64_t run = 1;
+                     for (++it; it != last && *it == x; ++it) {
+                        ++run;
+                     }
+                     bytes += varint_size(to_varint<I>(x)) + varint_size(run);
+                  }
+               }
+               count.add(bytes);
+            }
+         }
+         else if constexpr (glaze_object_t<V>) {
+            static constexpr auto N = std::tuple_size_v<meta_t<V>>;
+            if constexpr (Opts.trusted_layout || Opts.positional) {
+               if constexpr (!Opts.positional) {
+                  count.add(8);
+               }
+               for_each<N>([&](auto I) {
+                  static constexpr auto item = glz::tuplet::get<I>(meta_v<V>);
+                  binary_size<positional<Opts>()>(get_member(value, glz::tuplet::get<1>(item)), ctx, count);
+               });
+               return;
+            }
+            count.add(header_size(N));
+            if constexpr (Opts.offset_table) {
+               count.add(4 + 8 * N);
+            }
+            for_each<N>([&](auto I) {
+               static constexpr auto item = glz::tuplet::get<I>(meta_v<V>);
+               auto&& member = get_member(value, glz::tuplet::get<1>(item));
+               if constexpr (Opts.offset_table) {
+                  binary_size<Opts>(member, ctx, count);
+               }
+               else if constexpr (Opts.length_prefixed) {
+                  // dump_sized reserves a header32 and then shifts the value into place
+                  count.add(4);
+                  const size_t start = count.pos;
+                  count.add(4);
+                  binary_size<Opts>(member, ctx, count);
+                  const size_t n = count.pos - start - 4;
+                  if constexpr (Opts.aligned_arrays) {
+                     // the header is kept, or the value is written again behind a header64
+                     if (n >= 1073741824) {
+                        count.pos = start + 8;
+                        binary_size<Opts>(member, ctx, count);
+                     }
+                  }
+                  else {
+                     const size_t h = header_size(n);
+                     if (h > 4) {
+                        count.reach(count.pos + h - 4);
+                     }
+                     count.pos = start + h + n;
+                  }
+               }
+               else {
+                  count.add(4);
+                  binary_size<Opts>(member, ctx, count);
+               }
+            });
+         }
+         else if constexpr (glaze_array_t<V>) {
+            static constexpr auto N = std::tuple_size_v<meta_t<V>>;
+            if constexpr (Opts.offset_table) {
+               count.add(4 + 4 * N);
+            }
+            for_each<N>([&](auto I) { binary_size<Opts>(value.*glz::tuplet::get<I>(meta_v<V>), ctx, count); });
+         }
+         else if constexpr (map_t<V>) {
+            count.add(header_size(value.size()));
+            if constexpr (Opts.offset_table) {
+               count.add(4 + 4 * value.size());
+            }
+            for (auto&& [k, v] : value) {
+               binary_size<Opts>(k, ctx, count);
+               binary_size<Opts>(v, ctx, count);
+            }
+         }
+         else if constexpr (array_t<V>) {
+            if constexpr (!has_static_size<V>) {
+               count.add(header_size(value.size()));
+            }
+            if constexpr (contiguous_num_t<V>) {
+               using E = nano::ranges::range_value_t<V>;
+               if constexpr (Opts.aligned_arrays && alignof(E) > 1) {
+                  count.add(1 + (alignof(E) - (count.pos + 1) % alignof(E)) % alignof(E));
+               }
+               count.add(sizeof(E) * value.size());
+            }
+            else {
+               if constexpr (Opts.offset_table) {
+                  count.add(4 + 4 * value.size());
+               }
+               for (auto&& x : value) {
+                  binary_size<Opts>(x, ctx, count);
+               }
+            }
+         }
+         else if constexpr (nullable_t<V>) {
+            count.add(1);
+            if (value) {
+               binary_size<Opts>(*value, ctx, count);
+            }
+         }
+         else {
+            // types with custom writers are measured by writing them
+            count.add(measure_by_writing([&](auto& b, auto& ix) { write<binary>::op<Opts>(value, ctx, b, ix); }));
+         }
+      }
+
+      template <>
+      struct size_of<binary>
+      {
+         static constexpr bool exact = true;
+
+         template <auto Opts, class T>
+         static size_t op(T&& value, is_context auto&& ctx)
+         {
+            if constexpr (constexpr auto fixed = fixed_binary_size<Opts, T>(); fixed != dynamic_size) {
+               return fixed;
+            }
+            else {
+               size_count count{};
+               binary_size<Opts>(value, ctx, count);
+               return count.pos;
+            }
+         }
+
+         // sizes the buffer once so that the writer never grows it
+         template <auto Opts, class T, class Buffer>
+         static void write(T&& value, is_context auto&& ctx, Buffer& buffer)
+         {
+            size_count count{};
+            binary_size<Opts>(value, ctx, count);
+            buffer.resize(count.peak);
+            size_t ix = 0;
+            detail::write<binary>::op<Opts>(std::forward<T>(value), ctx, buffer, ix);
+            buffer.resize(ix);
+         }
+      };
+   }
+
+   /// <summary>
+   /// compile time binary size of T, for types whose binary size does not depend on their value
+   /// </summary>
+   template <class T, opts Opts = opts{.format = binary}>
+   requires(detail::fixed_binary_size<Opts, T>() != detail::dynamic_size)
+   inline constexpr size_t fixed_binary_size_v = detail::fixed_binary_size<Opts, T>();
+}
@@ -0,0 +1,237 @@
+// Glaze Library
+// For the license information refer to glaze.hpp
+
+#pragma once
+
+#include <charconv>
+#include <optional>
+#include <stdexcept>
+#include <string>
+
+#include "glaze/binary/read.hpp"
+#include "glaze/util/murmur.hpp"
+
+namespace glz
+{
+   namespace detail
+   {
+      // removes the first reference token from a JSON pointer, unescaping ~0 and ~1
+      inline bool view_key(sv& json_ptr, std::string& key)
+      {
+         if (json_ptr.size() < 2 || json_ptr[0] != '/') return false;
+
+         key.clear();
+         size_t i = 1;
+         for (; i < json_ptr.size(); ++i) {
+            auto c = json_ptr[i];
+            if (c == '/')
+               break;
+            else if (c == '~') {
+               if (++i == json_ptr.size()) return false;
+               c = json_ptr[i];
+               if (c == '0')
+                  c = '~';
+               else if (c == '1')
+                  c = '/';
+               else
+                  return false;
+            }
+            key.push_back(c);
+         }
+         json_ptr = json_ptr.substr(i);
+         return true;
+      }
+
+      template <class Num>
+      inline bool view_number(sv& json_ptr, Num& number)
+      {
+         if (json_ptr.size() < 2 || json_ptr[0] != '/') return false;
+
+         auto [p, ec] = std::from_chars(&json_ptr[1], json_ptr.data() + json_ptr.size(), number);
+         if (ec != std::errc{}) return false;
+         json_ptr = json_ptr.substr(p - json_ptr.data());
+         return true;
+      }
+
+      // Walks a message written with opts::offset_table, jumping through the offset tables so that only the value at
+      // the end of the path is decoded. Contiguous numeric arrays are indexed directly.
+      template <class T, auto Opts, class F>
+      bool view_seek(F&& func, const std::byte* it, const std::byte* end, sv json_ptr)
+      {
+         using V = std::decay_t<T>;
+         if constexpr (encoded_t<V>) {
+            // encoded arrays are decoded whole
+            std::remove_const_t<typename V::value_type> value{};
+            context ctx{};
+            read<binary>::op<Opts>(encoded<V::glaze_encoding, decltype(value)>{value}, ctx, it, end);
+            if (json_ptr.empty()) {
+               func(value);
+               return true;
+            }
+            size_t index{};
+            if (!view_number(json_ptr, index) || !json_ptr.empty() || index >= value.size()) return false;
+            func(value[index]);
+            return true;
+         }
+         else if (json_ptr.empty()) {
+            V value{};
+            context ctx{};
+            read<binary>::op<Opts>(value, ctx, it, end);
+            func(value);
+            return true;
+         }
+
+         if constexpr (glaze_object_t<V>) {
+            static thread_local std::string key{};
+            if (!view_key(json_ptr, key)) return false;
+
+            static constexpr auto storage = make_crusher_map<V>();
+            const auto hash = murmur3_32(key);
+            const auto p = storage.find(hash);
+            if (p == storage.end()) return false;
+
+            const auto n = int_from_header<Opts>(it, end);
+            const auto block = it;
+            for (size_t i = 0; i < n; ++i) {
+               const auto entry = block + 4 + 8 * i;
+               if (read_u32<Opts>(entry) == hash) {
+                  return std::visit(
+                     [&](auto&& member_ptr) {
+                        using M = std::decay_t<member_t<V, std::decay_t<decltype(member_ptr)>>>;
+                        return view_seek<M, Opts>(func, block + read_u32<Opts>(entry + 4), end, json_ptr);
+                     },
+                     p->second);
+               }
+            }
+            return false;
+         }
+         else if constexpr (glaze_array_t<V>) {
+            size_t index{};
+            if (!view_number(json_ptr, index)) return false;
+
+            static constexpr auto members = make_array<V>();
+            if (index >= members.size()) return false;
+
+            return std::visit(
+               [&](auto&& member_ptr) {
+                  using M = std::decay_t<decltype(std::declval<V&>().*member_ptr)>;
+                  return view_seek<M, Opts>(func, it + read_u32<Opts>(it + 4 + 4 * index), end, json_ptr);
+               },
+               members[index]);
+         }
+         else if constexpr (map_t<V>) {
+            using K = std::decay_t<typename V::key_type>;
+            static thread_local std::string key_str{};
+            K key{};
+            if constexpr (str_t<K>) {
+               if (!view_key(json_ptr, key_str)) return false;
+            }
+            else if constexpr (num_t<K>) {
+               if (!view_number(json_ptr, key)) return false;
+            }
+            else {
+               return false;
+            }
+
+            context ctx{};
+            const auto n = int_from_header<Opts>(it, end);
+            const auto block = it;
+            for (size_t i = 0; i < n; ++i) {
+               auto entry = block + read_u32<Opts>(block + 4 + 4 * i);
+               if constexpr (str_t<K>) {
+                  sv k{};
+                  read<binary>::op<Opts>(k, ctx, entry, end);
+                  if (k != key_str) continue;
+               }
+               else {
+                  K k{};
+                  read<binary>::op<Opts>(k, ctx, entry, end);
+                  if (k != key) continue;
+               }
+               return view_seek<typename V::mapped_type, Opts>(func, entry, end, json_ptr);
+            }
+            return false;
+         }
+         else if constexpr (array_t<V>) {
+            size_t index{};
+            if (!view_number(json_ptr, index)) return false;
+
+            size_t n{};
+            if constexpr (has_static_size<V>) {
+               n = get_size<V>();
+            }
+            else {
+               n = int_from_header<Opts>(it, end);
+            }
+            if (index >= n) return false;
+
+            using E = std::decay_t<nano::ranges::range_value_t<V>>;
+            if constexpr (contiguous_num_t<V>) {
+               if constexpr (Opts.aligned_arrays && alignof(E) > 1) {
+                  skip_padding(it);
+               }
+               return view_seek<E, Opts>(func, it + sizeof(E) * index, end, json_ptr);
+            }
+            else {
+               return view_seek<E, Opts>(func, it + read_u32<Opts>(it + 4 + 4 * index), end, json_ptr);
+            }
+         }
+         else if constexpr (nullable_t<V>) {
+            if (*it == std::byte{0}) return false;
+            using E = std::decay_t<decltype(*std::declval<V&>())>;
+            return view_seek<E, Opts>(func, it + 1, end, json_ptr);
+         }
+         else {
+            return false;
+         }
+      }
+   }
+
+   /// <summary>
+   /// random access into a binary message written with opts::offset_table
+   /// a member or JSON pointer path is resolved in O(depth) through the offset tables, and only the value it points to
+   /// is decoded
+   /// </summary>
+   template <class T, opts Opts = opts{.format = binary, .offset_table = true}>
+   struct binary_view
+   {
+      static_assert(Opts.offset_table, "binary_view requires opts::offset_table");
+
+      const std::byte* data{};
+      size_t size{};
+
+      binary_view() = default;
+
+      binary_view(const auto& buffer) noexcept
+         : data(reinterpret_cast<const std::byte*>(buffer.data())), size(buffer.size())
+      {}
+
+      // call a function on the decoded value at the location of a json_ptr, returns false if it does not exist
+      template <class F>
+      bool seek(F&& func, const sv json_ptr) const
+      {
+         return detail::view_seek<T, Opts>(std::forward<F>(func), data, data + size, json_ptr);
+      }
+
+      // decode the value at the location of a json_ptr, will throw if it does not exist or is the wrong type
+      template <class V>
+      V get(const sv json_ptr) const
+      {
+         std::optional<V> result{};
+         seek(
+            [&](auto&& val) {
+               if constexpr (std::same_as<V, std::decay_t<decltype(val)>>) {
+                  result = std::move(val);
+               }
+               else {
+                  throw std::runtime_error("Called get on \"" + std::string(json_ptr) + "\" with wrong type");
+               }
+            },
+            json_ptr);
+         if (!result) {
+            throw std::runtime_error("Called get on \"" + std::string(json_ptr) + "\" which doesnt exist");
+         }
+         return std::move(*result);
+      }
+   };
+}
@@ -6,12 +6,20 @@
 #include "glaze/core/opts.hpp"
 #include "glaze/util/dump.hpp"
 #include "glaze/binary/header.hpp"
+#include "glaze/binary/layout.hpp"
 #include "glaze/util/for_each.hpp"
 #include "glaze/core/write.hpp"
+#include "glaze/core/write_parallel.hpp"
 #include "glaze/json/json_ptr.hpp"
 #include "glaze/util/error.hpp"
+#include "glaze/util/gorilla.hpp"
 #include "glaze/util/murmur.hpp"
+#include "glaze/util/varint.hpp"
 
+#include <array>
+#include <limits>
+#include <span>
+#include <tuple>
 #include <utility>
 
 namespace glz
@@ -76,24 +84,137 @@ namespace glz
          return dump(std::as_bytes(std::span{ &value, 1 }), std::forward<Args>(args)...);
       }
 
-      template <uint64_t i, class... Args>
+      // current write offset from the start of the buffer
+      template <class B, class... IX>
+      size_t write_position(B&& b, IX&&... ix) noexcept
+      {
+         static_assert(sizeof...(IX) < 2);
+         if constexpr (sizeof...(IX) == 0) {
+            return b.size();
+         }
+         else {
+            return (size_t(ix), ...);
+         }
+      }
+
+      // moves the write position to n, growing the buffer if needed
+      template <class B, class... IX>
+      void set_write_position(const size_t n, B&& b, IX&&... ix) noexcept
+      {
+         static_assert(sizeof...(IX) < 2);
+         if constexpr (sizeof...(IX) == 0) {
+            b.resize(n);
+         }
+         else {
+            if (n > b.size()) {
+               b.resize(std::max(b.size() * 2, n));
+            }
+            ((ix = n), ...);
+         }
+      }
+
+      // writes a one byte pad count followed by that many zero bytes, so that the next byte is aligned to Align
+      // relative to the start of the buffer
+      template <size_t Align, class... Args>
+      void dump_padding(Args&&... args) noexcept
+      {
+         static_assert(Align <= 16);
+         static constexpr std::array<std::byte, 16> zeros{};
+         const auto pad = (Align - (write_position(args...) + 1) % Align) % Align;
+         dump_type(static_cast<uint8_t>(pad), args...);
+         dump(std::span{zeros.data(), pad}, args...);
+      }
+
+      template <class B, class... IX>
+      auto& buffer_of(B&& b, IX&&...) noexcept
+      {
+         return b;
+      }
+
+      // Table of uint32 offsets written ahead of the values it points to:
+      // [uint32 byte size of the block] [n entries of Stride bytes, the offset in the last four] [values...]
+      // Offsets and the block size are relative to the start of the block, entries are patched in as values are written.
+      template <size_t Stride>
+      struct offset_table
+      {
+         size_t base{};
+
+         template <class... Args>
+         static offset_table reserve(const size_t n, Args&&... args) noexcept
+         {
+            const size_t base = write_position(args...);
+            set_write_position(base + 4 + Stride * n, args...);
+            return {base};
+         }
+
+         template <auto Opts, class... Args>
+         void patch(const size_t pos, const uint32_t value, Args&&... args) const noexcept
+         {
+            const auto wire = wire_order<Opts>(value);
+            std::memcpy(reinterpret_cast<std::byte*>(buffer_of(args...).data()) + base + pos, &wire, 4);
+         }
+
+         template <auto Opts, class... Args>
+         void set_key(const size_t i, const uint32_t key, Args&&... args) const noexcept
+         {
+            patch<Opts>(4 + Stride * i, key, args...);
+         }
+
+         // points entry i at the current write position
+         template <auto Opts, class... Args>
+         void mark(const size_t i, Args&&... args) const noexcept(Opts.no_except)
+         {
+            patch<Opts>(Stride * (i + 1), relative<Opts>(args...), args...);
+         }
+
+         template <auto Opts, class... Args>
+         void finish(Args&&... args) const noexcept(Opts.no_except)
+         {
+            patch<Opts>(0, relative<Opts>(args...), args...);
+         }
+
+         template <auto Opts, class... Args>
+         uint32_t relative(Args&&... args) const noexcept(Opts.no_except)
+         {
+            const size_t offset = write_position(args...) - base;
+            if (offset > (std::numeric_limits<uint32_t>::max)()) [[unlikely]] {
+               if constexpr (!Opts.no_except) {
+                  throw std::runtime_error("offset table block exceeds 4 GB");
+               }
+            }
+            return static_cast<uint32_t>(offset);
+         }
+      };
+
+      template <auto Opts, class Header, class... Args>
+      auto dump_header(const Header h, Args&&... args) noexcept
+      {
+         if constexpr (swap_bytes<Opts>) {
+            return dump_type(canonical_header(h), std::forward<Args>(args)...);
+         }
+         else {
+            return dump_type(h, std::forward<Args>(args)...);
+         }
+      }
+
+      template <uint64_t i, auto Opts = opts{}, class... Args>
       [[nodiscard]] auto dump_int(Args&&... args) noexcept
       {
          if constexpr (i < 64) {
             static constexpr auto h = header8{ 0, static_cast<uint8_t>(i) };
-            return dump_type(h, std::forward<Args>(args)...);
+            return dump_header<Opts>(h, std::forward<Args>(args)...);
          }
          else if constexpr (i < 16384) {
             static constexpr auto h = header16{ 1, static_cast<uint16_t>(i) };
-            return dump_type(h, std::forward<Args>(args)...);
+            return dump_header<Opts>(h, std::forward<Args>(args)...);
          }
          else if constexpr (i < 1073741824) {
             static constexpr auto h = header32{ 2, static_cast<uint32_t>(i) };
-            return dump_type(h, std::forward<Args>(args)...);
+            return dump_header<Opts>(h, std::forward<Args>(args)...);
          }
          else if constexpr (i < 4611686018427387904) {
             static constexpr auto h = header64{ 3, i };
-            return dump_type(h, std::forward<Args>(args)...);
+            return dump_header<Opts>(h, std::forward<Args>(args)...);
          }
          else {
             static_assert(i >= 4611686018427387904,
@@ -105,16 +226,16 @@ namespace glz
       [[nodiscard]] auto dump_int(size_t i, Args&&... args) noexcept(Opts.no_except)
       {
          if (i < 64) {
-            return dump_type(header8{ 0, static_cast<uint8_t>(i) }, std::forward<Args>(args)...);
+            return dump_header<Opts>(header8{ 0, static_cast<uint8_t>(i) }, std::forward<Args>(args)...);
          }
          else if (i < 16384) {
-            return dump_type(header16{ 1, static_cast<uint16_t>(i) }, std::forward<Args>(args)...);
+            return dump_header<Opts>(header16{ 1, static_cast<uint16_t>(i) }, std::forward<Args>(args)...);
          }
          else if (i < 1073741824) {
-            return dump_type(header32{ 2, static_cast<uint32_t>(i) }, std::forward<Args>(args)...);
+            return dump_header<Opts>(header32{ 2, static_cast<uint32_t>(i) }, std::forward<Args>(args)...);
          }
          else if (i < 4611686018427387904) {
-            return dump_type(header64{ 3, i }, std::forward<Args>(args)...);
+            return dump_header<Opts>(header64{ 3, i }, std::forward<Args>(args)...);
          }
          else {
             if constexpr (Opts.no_except) {
@@ -133,7 +254,7 @@ namespace glz
          template <auto Opts, class... Args>
          static auto op(auto&& value, is_context auto&&, Args&&... args) noexcept
          {
-            return dump_type(value, std::forward<Args>(args)...);
+            return dump_type(wire_order<Opts>(value), std::forward<Args>(args)...);
          }
       };
 
@@ -144,10 +265,22 @@ namespace glz
          static auto op(auto&& value, is_context auto&&, Args&&... args) noexcept(Opts.no_except)
          {
             dump_int<Opts>(value.size(), std::forward<Args>(args)...);
-            dump(std::as_bytes(std::span{ value.data(), value.size() }), std::forward<Args>(args)...);
+            using C = std::decay_t<decltype(*value.data())>;
+            if constexpr (swap_bytes<Opts> && sizeof(C) > 1) {
+               for (auto&& c : value) {
+                  dump_type(wire_order<Opts>(c), args...);
+               }
+            }
+            else {
+               dump(std::as_bytes(std::span{ value.data(), value.size() }), std::forward<Args>(args)...);
+            }
          }
       };
 
+      // chunks written in parallel are padded relative to their own buffer, so aligned arrays are written serially
+      template <auto Opts, class T>
+      concept parallel_binary_writable = parallel_writable<Opts, T> && !Opts.aligned_arrays;
+
       template <array_t T>
       struct to_binary<T> final
       {
@@ -157,6 +290,43 @@ namespace glz
             if constexpr (!has_static_size<T>) {
                dump_int<Opts>(value.size(), std::forward<Args>(args)...);
             }
+            if constexpr (contiguous_num_t<T>) {
+               using V = nano::ranges::range_value_t<T>;
+               if constexpr (Opts.aligned_arrays && alignof(V) > 1) {
+                  dump_padding<alignof(V)>(args...);
+               }
+               if (value.size() == 0) {
+                  return;
+               }
+               const size_t start = write_position(args...);
+               dump(std::as_bytes(std::span{value.data(), value.size()}), std::forward<Args>(args)...);
+               if constexpr (swap_bytes<Opts>) {
+                  byteswap_array(reinterpret_cast<V*>(buffer_of(args...).data() + start), value.size());
+               }
+               return;
+            }
+            else if constexpr (Opts.offset_table) {
+               const auto table = offset_table<4>::reserve(value.size(), args...);
+               size_t i = 0;
+               for (auto&& x : value) {
+                  table.template mark<Opts>(i++, args...);
+                  write<binary>::op<Opts>(x, ctx, args...);
+               }
+               table.template finish<Opts>(args...);
+               return;
+            }
+            if constexpr (parallel_binary_writable<Opts, T>) {
+               if (use_parallel(value, ctx)) {
+                  auto write_element = [](auto&& it, const size_t, auto&& c, auto&& b, auto&& ix) {
+                     write<binary>::op<serial<Opts>()>(*it, c, b, ix);
+                  };
+                  const auto chunks = write_chunks(value, ctx, write_element);
+                  for (auto& chunk : chunks) {
+                     dump(std::as_bytes(std::span{chunk.data(), chunk.size()}), std::forward<Args>(args)...);
+                  }
+                  return;
+               }
+            }
             for (auto&& x : value) {
                write<binary>::op<Opts>(x, ctx, std::forward<Args>(args)...);
             }
@@ -170,6 +340,31 @@ namespace glz
          static auto op(auto&& value, is_context auto&& ctx, Args&&... args) noexcept(Opts.no_except)
          {
             dump_int<Opts>(value.size(), std::forward<Args>(args)...);
+            if constexpr (Opts.offset_table) {
+               // entries point at each key, the value follows its key
+               const auto table = offset_table<4>::reserve(value.size(), args...);
+               size_t i = 0;
+               for (auto&& [k, v] : value) {
+                  table.template mark<Opts>(i++, args...);
+                  write<binary>::op<Opts>(k, ctx, args...);
+                  write<binary>::op<Opts>(v, ctx, args...);
+               }
+               table.template finish<Opts>(args...);
+               return;
+            }
+            if constexpr (parallel_binary_writable<Opts, T>) {
+               if (use_parallel(value, ctx)) {
+                  auto write_element = [](auto&& it, const size_t, auto&& c, auto&& b, auto&& ix) {
+                     write<binary>::op<serial<Opts>()>(it->first, c, b, ix);
+                     write<binary>::op<serial<Opts>()>(it->second, c, b, ix);
+                  };
+                  const auto chunks = write_chunks(value, ctx, write_element);
+                  for (auto& chunk : chunks) {
+                     dump(std::as_bytes(std::span{chunk.data(), chunk.size()}), std::forward<Args>(args)...);
+                  }
+                  return;
+               }
+            }
             for (auto&& [k, v] : value) {
                write<binary>::op<Opts>(k, ctx, std::forward<Args>(args)...);
                write<binary>::op<Opts>(v, ctx, std::forward<Args>(args)...);
@@ -193,6 +388,172 @@ namespace glz
          }
       };
 
+      // Writes a value behind a header holding its size in bytes. A header32 is reserved up front and the value is
+      // shifted down once its size is known, so small values still get a one or two byte header.
+      // With aligned_arrays the value is never moved and the header stays a header32.
+      template <auto Opts, class B, class... IX>
+      void dump_sized(auto&& write_value, B&& b, IX&&... ix) noexcept(Opts.no_except)
+      {
+         const size_t start = write_position(b, ix...);
+         dump_header<Opts>(header32{}, b, ix...);
+         write_value();
+         const size_t finish = write_position(b, ix...);
+         const size_t n = finish - start - sizeof(header32);
+
+         auto patch = [&](const auto h) {
+            static constexpr auto shift = sizeof(h);
+            if constexpr (shift > sizeof(header32)) {
+               set_write_position(finish + shift - sizeof(header32), b, ix...);
+            }
+            auto data = reinterpret_cast<std::byte*>(b.data()) + start;
+            if constexpr (shift != sizeof(header32)) {
+               std::memmove(data + shift, data + sizeof(header32), n);
+            }
+            if constexpr (swap_bytes<Opts>) {
+               const auto wire = canonical_header(h);
+               std::memcpy(data, &wire, shift);
+            }
+            else {
+               std::memcpy(data, &h, shift);
+            }
+            if constexpr (shift < sizeof(header32)) {
+               set_write_position(finish + shift - sizeof(header32), b, ix...);
+            }
+         };
+
+         if constexpr (Opts.aligned_arrays) {
+            // shifting the value would undo the padding of its arrays, so the header is never shrunk, and a value too
+            // large for a header32 is written again behind a header64
+            if (n < 1073741824) {
+               patch(header32{2, static_cast<uint32_t>(n)});
+            }
+            else {
+               set_write_position(start, b, ix...);
+               dump_header<Opts>(header64{}, b, ix...);
+               write_value();
+               const header64 h{3, write_position(b, ix...) - start - sizeof(header64)};
+               auto data = reinterpret_cast<std::byte*>(b.data()) + start;
+               if constexpr (swap_bytes<Opts>) {
+                  const auto wire = canonical_header(h);
+                  std::memcpy(data, &wire, sizeof(h));
+               }
+               else {
+                  std::memcpy(data, &h, sizeof(h));
+               }
+            }
+            return;
+         }
+         if (n < 64) {
+            patch(header8{0, static_cast<uint8_t>(n)});
+         }
+         else if (n < 16384) {
+            patch(header16{1, static_cast<uint16_t>(n)});
+         }
+         else if (n < 1073741824) {
+            patch(header32{2, static_cast<uint32_t>(n)});
+         }
+         else if (n < 4611686018427387904) {
+            patch(header64{3, n});
+         }
+         else {
+            if constexpr (Opts.no_except) {
+               return;
+            }
+            else {
+               throw std::runtime_error("size not supported");
+            }
+         }
+      }
+
+      // Gorilla stream: [value count] [bit count] [bit count / 64 rounded up uint64 words]
+      template <auto Opts, class... Args>
+      void dump_gorilla(const size_t n, const size_t bits, const std::vector<uint64_t>& words,
+                        Args&&... args) noexcept(Opts.no_except)
+      {
+         dump_int<Opts>(n, args...);
+         dump_int<Opts>(bits, args...);
+         if (words.empty()) {
+            return;
+         }
+         const size_t start = write_position(args...);
+         dump(std::as_bytes(std::span{words.data(), words.size()}), args...);
+         if constexpr (swap_bytes<Opts>) {
+            byteswap_array(reinterpret_cast<uint64_t*>(buffer_of(args...).data() + start), words.size());
+         }
+      }
+
+      template <class T>
+      struct to_binary<compressed<T>> final
+      {
+         template <auto Opts, class... Args>
+         static void op(auto&& value, is_context auto&&, Args&&... args) noexcept(Opts.no_except)
+         {
+            dump_gorilla<Opts>(value.size(), value.bit_size(), value.words(), args...);
+         }
+      };
+
+      template <encoding E, class T>
+      struct to_binary<encoded<E, T>> final
+      {
+         template <auto Opts, class... Args>
+         static void op(auto&& value, is_context auto&& ctx, Args&&... args) noexcept(Opts.no_except)
+         {
+            auto& v = value.value;
+            if constexpr (E == encoding::none) {
+               write<binary>::op<Opts>(v, ctx, args...);
+            }
+            else if constexpr (E == encoding::gorilla) {
+               using I = std::decay_t<nano::ranges::range_value_t<std::decay_t<T>>>;
+               compressed<I> stream{};
+               for (auto&& x : v) {
+                  stream.push_back(x);
+               }
+               to_binary<compressed<I>>::template op<Opts>(stream, ctx, args...);
+            }
+            else {
+               using I = std::decay_t<nano::ranges::range_value_t<std::decay_t<T>>>;
+               static_assert(int_t<I>, "compact encodings require an array of integers");
+               const size_t n = v.size();
+               dump_int<Opts>(n, args...);
+
+               // encode straight into the buffer, then trim to the bytes used
+               const size_t start = write_position(args...);
+               set_write_position(start + max_varint_bytes * (E == encoding::rle ? 2 * n : n), args...);
+               auto* const first = reinterpret_cast<uint8_t*>(buffer_of(args...).data()) + start;
+               auto* out = first;
+
+               if constexpr (E == encoding::varint) {
+                  for (auto&& x : v) {
+                     out = encode_varint(to_varint<I>(x), out);
+                  }
+               }
+               else if constexpr (E == encoding::delta) {
+                  uint64_t prev{};
+                  for (auto&& x : v) {
+                     const auto current = static_cast<uint64_t>(x);
+                     out = encode_varint(zigzag_encode(static_cast<int64_t>(current - prev)), out);
+                     prev = current;
+                  }
+               }
+               else if constexpr (E == encoding::rle) {
+                  auto it = v.begin();
+                  const auto last = v.end();
+                  while (it != last) {
+                     const I x = *it;
+                     uint64_t count = 1;
+                     for (++it; it != last && *it == x; ++it) {
+                        ++count;
+                     }
+                     out = encode_varint(to_varint<I>(x), out);
+                     out = encode_varint(count, out);
+                  }
+               }
+
+               set_write_position(start + static_cast<size_t>(out - first), args...);
+            }
+         }
+      };
+
       template <class T>
       requires glaze_object_t<T>
       struct to_binary<T> final
@@ -202,14 +563,46 @@ namespace glz
          {
             using V = std::decay_t<T>;
             static constexpr auto N = std::tuple_size_v<meta_t<V>>;
-            dump_int<N>(args...); // even though N is known at compile time in this case, it is not known for partial cases, so we still use a compressed integer
+
+            if constexpr (Opts.trusted_layout || Opts.positional) {
+               // a single layout hash for the whole message, nested objects are positional as well
+               if constexpr (!Opts.positional) {
+                  dump_type(wire_order<Opts>(layout_hash_v<V>), args...);
+               }
+               for_each<N>([&](auto I) {
+                  static constexpr auto item = glz::tuplet::get<I>(meta_v<V>);
+                  write<binary>::op<positional<Opts>()>(get_member(value, glz::tuplet::get<1>(item)), ctx, args...);
+               });
+               return;
+            }
+
+            dump_int<N, Opts>(args...); // even though N is known at compile time in this case, it is not known for partial cases, so we still use a compressed integer
+
+            if constexpr (Opts.offset_table) {
+               const auto table = offset_table<8>::reserve(N, args...);
+               for_each<N>([&](auto I) {
+                  static constexpr auto item = glz::tuplet::get<I>(meta_v<V>);
+                  static constexpr uint32_t hash = murmur3_32(glz::tuplet::get<0>(item));
+                  table.template set_key<Opts>(I, hash, args...);
+                  table.template mark<Opts>(I, args...);
+                  write<binary>::op<Opts>(get_member(value, glz::tuplet::get<1>(item)), ctx, args...);
+               });
+               table.template finish<Opts>(args...);
+               return;
+            }
 
             for_each<N>([&](auto I) {
                static constexpr auto item = glz::tuplet::get<I>(meta_v<V>);
                static constexpr uint32_t hash = murmur3_32(glz::tuplet::get<0>(item));
-               dump_type(hash, args...);
-               using V = std::tuple_element_t<1, decltype(item)>;
-               write<binary>::op<Opts>(get_member(value, glz::tuplet::get<1>(item)), ctx, args...);
+               dump_type(wire_order<Opts>(hash), args...);
+               if constexpr (Opts.length_prefixed) {
+                  dump_sized<Opts>(
+                     [&] { write<binary>::op<Opts>(get_member(value, glz::tuplet::get<1>(item)), ctx, args...); },
+                     args...);
+               }
+               else {
+                  write<binary>::op<Opts>(get_member(value, glz::tuplet::get<1>(item)), ctx, args...);
+               }
             });
          }
       };
@@ -219,10 +612,20 @@ namespace glz
       struct to_binary<T> final
       {
          template <auto Opts, class... Args>
-         static auto op(auto&& value, is_context auto&& ctx, Args&&... args) noexcept
+         static auto op(auto&& value, is_context auto&& ctx, Args&&... args) noexcept(Opts.no_except)
          {
             using V = std::decay_t<T>;
-            for_each<std::tuple_size_v<meta_t<V>>>([&](auto I) {
+            static constexpr auto N = std::tuple_size_v<meta_t<V>>;
+            if constexpr (Opts.offset_table) {
+               const auto table = offset_table<4>::reserve(N, args...);
+               for_each<N>([&](auto I) {
+                  table.template mark<Opts>(I, args...);
+                  write<binary>::op<Opts>(value.*glz::tuplet::get<I>(meta_v<V>), ctx, args...);
+               });
+               table.template finish<Opts>(args...);
+               return;
+            }
+            for_each<N>([&](auto I) {
                write<binary>::op<Opts>(value.*glz::tuplet::get<I>(meta_v<V>), ctx, std::forward<Args>(args)...);
             });
          }
@@ -259,7 +662,7 @@ namespace glz
          static constexpr auto N =
             std::tuple_size_v<std::decay_t<decltype(groups)>>;
 
-         detail::dump_int<N>(buffer);
+         detail::dump_int<N, Opts>(buffer);
 
          if constexpr (detail::glaze_object_t<std::decay_t<T>>) {
             glz::for_each<N>([&](auto I) {
@@ -279,8 +682,15 @@ namespace glz
                static constexpr decltype(auto) member_ptr = std::get<ix>(member_it->second);
                
                static constexpr uint32_t hash = murmur3_32(key);
-               detail::dump_type(hash, buffer);
-               write<sub_partial, Opts>(glz::detail::get_member(value, member_ptr), buffer, ctx);
+               detail::dump_type(detail::wire_order<Opts>(hash), buffer);
+               if constexpr (Opts.length_prefixed) {
+                  detail::dump_sized<Opts>(
+                     [&] { write<sub_partial, Opts>(glz::detail::get_member(value, member_ptr), buffer, ctx); },
+                     buffer);
+               }
+               else {
+                  write<sub_partial, Opts>(glz::detail::get_member(value, member_ptr), buffer, ctx);
+               }
             });
          }
          else if constexpr (detail::map_t<std::decay_t<T>>) {
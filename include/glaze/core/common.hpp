@@ -38,6 +38,43 @@ namespace glz
       T& value;
    };
    
+   // Compact binary encodings for numeric arrays, other formats read and write the underlying value unchanged
+   enum struct encoding : uint32_t
+   {
+      none,
+      varint, // LEB128, zigzagged for signed integers
+      delta, // zigzag varint differences between consecutive values, for sorted or slowly changing data
+      rle, // runs of (varint value, varint count)
+      gorilla // XOR compressed floating point and delta of delta integers, for time series (see glz::compressed)
+   };
+   
+   template <encoding E, class T>
+   struct encoded
+   {
+      static constexpr encoding glaze_encoding = E;
+      using value_type = T;
+      T& value;
+   };
+   
+   // Select an encoding for a member in glz::meta, e.g. "counts", glz::varint<&T::counts>
+   template <encoding E, auto MemPtr>
+   inline constexpr auto encode = [](auto&& v) {
+      using V = std::remove_reference_t<decltype(v.*MemPtr)>;
+      return encoded<E, V>{v.*MemPtr};
+   };
+   
+   template <auto MemPtr>
+   inline constexpr auto varint = encode<encoding::varint, MemPtr>;
+   
+   template <auto MemPtr>
+   inline constexpr auto delta = encode<encoding::delta, MemPtr>;
+   
+   template <auto MemPtr>
+   inline constexpr auto rle = encode<encoding::rle, MemPtr>;
+   
+   template <auto MemPtr>
+   inline constexpr auto gorilla = encode<encoding::gorilla, MemPtr>;
+   
    namespace detail
    {
       template <class T>
@@ -310,6 +347,9 @@ namespace glz
       template <class T>
       concept vector_like = resizeable<T> && accessible<T> && has_data<T>;
       
+      template <class T>
+      concept contiguous_num_t = nano::ranges::contiguous_range<T> && num_t<nano::ranges::range_value_t<T>>;
+      
       template <class T>
       concept is_span = requires(T t)
       {
@@ -365,6 +405,9 @@ namespace glz
 
       template <class T>
       concept glaze_object_t = glaze_t<T> && is_specialization_v<meta_wrapper_t<T>, Object>;
+      
+      template <class T>
+      concept encoded_t = requires { std::decay_t<T>::glaze_encoding; };
 
       template <class T>
       concept glaze_enum_t = glaze_t<T> && is_specialization_v<meta_wrapper_t<T>, Enum>;
@@ -3,10 +3,13 @@
 
 #pragma once
 
+#include <cstddef>
 #include <string_view>
 
 namespace glz
 {
+   struct pool;
+   
    // Runtime context for configuration
    // We do not template the context on iterators so that it can be easily shared across buffer implementations
    struct context final
@@ -15,6 +18,8 @@ namespace glz
       char indentation_char = ' ';
       uint8_t indentation_width = 3;
       std::string current_file; // top level file path
+      pool* thread_pool{}; // pool used by opts::parallel writes, serial when null
+      size_t parallel_threshold = 8192; // minimum number of elements before a container is split across the pool
       
       // INTERNAL USE
       uint32_t indentation_level{};
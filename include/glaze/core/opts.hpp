@@ -18,9 +18,17 @@ namespace glz
       bool allow_hash_check = false; // Will replace some string equality checks with hash checks
       bool prettify = false; // write out prettified JSON
       bool rowwise = true; // rowwise output for csv, false is column wise
+      bool parallel = false; // split large containers across the context's thread pool when writing
+      bool trusted_layout = false; // binary objects are written as a layout hash followed by members without keys
+      bool length_prefixed = false; // binary object members are prefixed with their size so unknown keys can be skipped
+      bool aligned_arrays = false; // pad binary numeric arrays to their alignment so they can be read as spans
+      bool offset_table = false; // binary objects and arrays carry member offsets for random access with glz::binary_view
+      bool little_endian = false; // canonical little endian binary, byte swapped on big endian hosts
+      bool presize = false; // binary: measure the output with glz::serialized_size first so the buffer is allocated once
       
       // INTERNAL USE
       bool opening_handled = false; // the opening character has been handled
+      bool positional = false; // the layout hash has been handled, members are in declaration order without keys
    };
    
    template <opts Opts>
@@ -30,4 +38,28 @@ namespace glz
       ret.opening_handled = true;
       return ret;
    };
+   
+   template <opts Opts>
+   constexpr auto serial()
+   {
+      opts ret = Opts;
+      ret.parallel = false;
+      return ret;
+   };
+   
+   template <opts Opts>
+   constexpr auto positional()
+   {
+      opts ret = Opts;
+      ret.positional = true;
+      return ret;
+   };
+   
+   template <opts Opts>
+   constexpr auto keyed()
+   {
+      opts ret = Opts;
+      ret.trusted_layout = false;
+      return ret;
+   };
 }
@@ -15,12 +15,68 @@ namespace glz
    template <class Buffer>
    concept output_buffer = nano::ranges::input_range<Buffer> && (sizeof(nano::ranges::range_value_t<Buffer>) == sizeof(char));
    
+   namespace detail
+   {
+      // Measures an output by writing it into thread local scratch space. The space is kept for the next
+      // measurement unless the output was large, so a thread does not hold on to its largest output.
+      inline size_t measure_by_writing(auto&& write_into)
+      {
+         static constexpr size_t max_retained = 64 * 1024;
+         static thread_local std::string scratch{};
+         if (scratch.size() < 128) {
+            scratch.resize(128);
+         }
+         size_t ix = 0;
+         write_into(scratch, ix);
+         if (scratch.size() > max_retained) {
+            std::string{}.swap(scratch);
+         }
+         return ix;
+      }
+
+      // Measures the output of a format by writing it, so the size is exact by construction.
+      // Formats with a layout that can be computed without writing specialize this and set exact.
+      template <uint32_t Format>
+      struct size_of
+      {
+         static constexpr bool exact = false;
+
+         template <auto Opts, class T>
+         static size_t op(T&& value, is_context auto&& ctx)
+         {
+            return measure_by_writing(
+               [&](auto& b, auto& ix) { detail::write<Format>::template op<Opts>(std::forward<T>(value), ctx, b, ix); });
+         }
+      };
+   }
+
+   /// <summary>
+   /// exact number of bytes that write<Opts> produces for value
+   /// </summary>
+   template <opts Opts, class T>
+   inline size_t serialized_size(T&& value, is_context auto&& ctx)
+   {
+      return detail::size_of<Opts.format>::template op<Opts>(std::forward<T>(value), ctx);
+   }
+
+   template <opts Opts, class T>
+   inline size_t serialized_size(T&& value)
+   {
+      context ctx{};
+      return serialized_size<Opts>(std::forward<T>(value), ctx);
+   }
+
    // For writing to a std::string, std::vector<char>, std::deque<char> and
    // the like
    template <opts Opts, class T, output_buffer Buffer>
    inline void write(T&& value, Buffer& buffer, is_context auto&& ctx) noexcept
    {
-      if constexpr (std::same_as<Buffer, std::string> || std::same_as<Buffer, std::vector<std::byte>>) {
+      if constexpr (Opts.presize && (std::same_as<Buffer, std::string> || std::same_as<Buffer, std::vector<std::byte>>)) {
+         static_assert(detail::size_of<Opts.format>::exact,
+                       "presize needs a format whose size is computed without writing, such as binary");
+         detail::size_of<Opts.format>::template write<Opts>(std::forward<T>(value), ctx, buffer);
+      }
+      else if constexpr (std::same_as<Buffer, std::string> || std::same_as<Buffer, std::vector<std::byte>>) {
          if (buffer.empty()) {
             buffer.resize(128);
          }
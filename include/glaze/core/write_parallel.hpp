@@ -0,0 +1,68 @@
+// Glaze Library
+// For the license information refer to glaze.hpp
+
+#pragma once
+
+#include <algorithm>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "glaze/core/common.hpp"
+#include "glaze/core/opts.hpp"
+#include "glaze/thread/threadpool.hpp"
+
+namespace glz::detail
+{
+   // number of elements below which a chunk is not worth a task
+   inline constexpr size_t min_parallel_chunk = 1024;
+
+   template <auto Opts, class T>
+   concept parallel_writable = Opts.parallel && nano::ranges::sized_range<T>;
+
+   inline bool use_parallel(auto&& value, is_context auto&& ctx) noexcept
+   {
+      return ctx.thread_pool && ctx.thread_pool->size() > 1 && value.size() >= ctx.parallel_threshold;
+   }
+
+   /// <summary>
+   /// serializes the elements of a container into per task buffers on the context's thread pool
+   /// write_element(it, index, ctx, b, ix) must write any leading separator itself, so that appending the returned
+   /// chunks in order reproduces the serial output byte for byte
+   /// </summary>
+   inline std::vector<std::string> write_chunks(auto&& value, is_context auto&& ctx, auto&& write_element)
+   {
+      auto& pool = *ctx.thread_pool;
+      const size_t n = value.size();
+      const size_t n_chunks = std::max(std::min(4 * pool.size(), n / min_parallel_chunk), size_t{1});
+
+      std::vector<std::string> chunks(n_chunks);
+
+      // the start of every chunk, found in one pass as the container may not be random access
+      using iterator = decltype(std::begin(value));
+      std::vector<iterator> starts;
+      starts.reserve(n_chunks + 1);
+      auto position = std::begin(value);
+      size_t start = 0;
+      for (size_t i = 0; i <= n_chunks; ++i) {
+         const size_t stop = n * i / n_chunks;
+         position = std::next(position, stop - start);
+         starts.emplace_back(position);
+         start = stop;
+      }
+
+      pool.parallel_for(0, n_chunks, 1, [&](const size_t i) {
+         std::decay_t<decltype(ctx)> local_ctx = ctx; // contexts are not shared across threads
+         auto& chunk = chunks[i];
+         chunk.resize(128);
+         size_t ix = 0;
+         size_t index = n * i / n_chunks;
+         for (auto it = starts[i]; it != starts[i + 1]; ++it, ++index) {
+            write_element(it, index, local_ctx, chunk, ix);
+         }
+         chunk.resize(ix);
+      });
+
+      return chunks;
+   }
+}
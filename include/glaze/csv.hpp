@@ -4,4 +4,5 @@
 #pragma once
 
 #include "glaze/csv/read.hpp"
+#include "glaze/csv/sink.hpp"
 #include "glaze/csv/write.hpp"
@@ -3,15 +3,29 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstring>
 #include <fstream>
+#include <iterator>
+#include <string>
 #include <sstream>
+#include <tuple>
+#include <vector>
 
 #include "fmt/format.h"
 #include "fmt/compile.h"
+#include "fast_float/fast_float.h"
 
+#include "glaze/file/mapped_file.hpp"
 #include "glaze/record/recorder.hpp"
+#include "glaze/thread/threadpool.hpp"
 #include "glaze/util/type_traits.hpp"
 #include "glaze/util/for_each.hpp"
+#include "glaze/util/string_view.hpp"
+#include "glaze/util/swar.hpp"
+#include "glaze/util/tuple.hpp"
 #include "glaze/core/common.hpp"
 #include "glaze/core/format.hpp"
 #include "glaze/core/opts.hpp"
@@ -22,105 +36,694 @@
 
 namespace glz
 {
-   template<class T>
-   inline void convert_value(std::stringstream& buffer, T& var) requires std::is_floating_point_v<T>
+   namespace detail
    {
-       buffer >> var;
+      [[noreturn]] inline void csv_conversion_error()
+      {
+         throw std::runtime_error("csv | could not convert to type");
+      }
+
+      template <char... Cs>
+      inline sv trim_csv_field(sv field) noexcept
+      {
+         while (field.size() && (field.front() == ' ' || field.front() == '\t' || ((field.front() == Cs) || ...))) {
+            field.remove_prefix(1);
+         }
+         while (field.size() && (field.back() == ' ' || field.back() == '\t' || ((field.back() == Cs) || ...))) {
+            field.remove_suffix(1);
+         }
+         return field;
+      }
+
+      inline bool quoted_csv_field(const sv trimmed) noexcept
+      {
+         return trimmed.size() >= 2 && trimmed.front() == '"' && trimmed.back() == '"';
+      }
+
+      // a trimmed field without its quotes, escaped quotes ("") are left doubled
+      inline sv unquote_csv_field(sv field) noexcept
+      {
+         field = trim_csv_field(field);
+         if (quoted_csv_field(field)) {
+            field = field.substr(1, field.size() - 2);
+         }
+         return field;
+      }
+
+      template <class T>
+      concept csv_value = std::is_arithmetic_v<T> || std::same_as<T, std::string>;
+
+      // the text of a quoted field with escaped quotes ("") collapsed, a lone quote is kept as is
+      inline void unescape_csv_field(sv field, std::string& value)
+      {
+         value.clear();
+         while (true) {
+            const auto q = field.find('"');
+            if (q == sv::npos) {
+               value.append(field);
+               return;
+            }
+            value.append(field.substr(0, q + 1));
+            field.remove_prefix(q + 1 + (q + 1 < field.size() && field[q + 1] == '"'));
+         }
+      }
+
+      // parses a whole field, surrounding spaces and quotes are ignored
+      // strings keep the spaces of an unquoted field and have the escaped quotes of a quoted field collapsed
+      template <csv_value T>
+      inline void parse_csv_value(sv field, T& value)
+      {
+         if constexpr (std::same_as<T, std::string>) {
+            const auto trimmed = trim_csv_field(field);
+            if (quoted_csv_field(trimmed)) {
+               unescape_csv_field(trimmed.substr(1, trimmed.size() - 2), value);
+            }
+            else {
+               value.assign(field);
+            }
+         }
+         else {
+            // values never contain quotes, so the quotes of a quoted field are trimmed along with the spaces
+            field = trim_csv_field<'"'>(field);
+            const auto first = field.data();
+            const auto last = first + field.size();
+            if constexpr (std::is_same_v<T, bool>) {
+               if (field == "1") {
+                  value = true;
+               }
+               else if (field == "0") {
+                  value = false;
+               }
+               else {
+                  csv_conversion_error();
+               }
+            }
+            else if constexpr (std::is_same_v<T, char>) {
+               if (field.size() != 1) {
+                  csv_conversion_error();
+               }
+               value = field.front();
+            }
+            else if constexpr (std::is_floating_point_v<T>) {
+               auto [p, ec] = fast_float::from_chars(first, last, value);
+               if (ec != std::errc{} || p != last || first == last) {
+                  csv_conversion_error();
+               }
+            }
+            else {
+               auto [p, ec] = std::from_chars(first, last, value);
+               if (ec != std::errc{} || p != last || first == last) {
+                  csv_conversion_error();
+               }
+            }
+         }
+      }
+
+      // start of the next line, newlines inside quoted fields do not end a line
+      inline const char* skip_csv_line(const char* it, const char* end) noexcept
+      {
+         while (it < end) {
+            it = find_first_of<false, '"', '\n'>(it, end);
+            if (it == end) {
+               break;
+            }
+            if (*it == '\n') {
+               return it + 1;
+            }
+            const auto close = static_cast<const char*>(std::memchr(it + 1, '"', static_cast<size_t>(end - it - 1)));
+            it = close ? close + 1 : end;
+         }
+         return end;
+      }
+
+      // bit masks of the structural characters of 64 bytes, bit i is the byte at offset i
+      struct csv_block
+      {
+         uint64_t quotes{};
+         uint64_t delimiters{}; // ',' and '\n'
+      };
+
+      inline csv_block classify_csv_block(const char* p) noexcept
+      {
+         csv_block block{};
+         uint64_t quotes[8];
+         uint64_t any_quote{};
+         for (size_t i = 0; i < 8; ++i) {
+            // match_bytes for the three characters, sharing the masking of the chunk
+            const auto chunk = load_u64(p + 8 * i);
+            const auto low = chunk & low_bits;
+            const auto high = chunk | low_bits;
+            const auto comma = (low ^ repeat_byte(',')) + low_bits;
+            const auto newline = (low ^ repeat_byte('\n')) + low_bits;
+            const auto quote = (low ^ repeat_byte('"')) + low_bits;
+            block.delimiters |= movemask(~((comma & newline) | high)) << (8 * i);
+            quotes[i] = ~(quote | high);
+            any_quote |= quotes[i];
+         }
+         // most blocks hold no quotes
+         if (any_quote) {
+            for (size_t i = 0; i < 8; ++i) {
+               block.quotes |= movemask(quotes[i]) << (8 * i);
+            }
+         }
+         return block;
+      }
+
+      // the last bytes of the text, padded with zeros to a whole block
+      inline csv_block classify_csv_tail(const char* p, const char* end) noexcept
+      {
+         char tail[64]{};
+         std::memcpy(tail, p, static_cast<size_t>(end - p));
+         return classify_csv_block(tail);
+      }
+
+      /// <summary>
+      /// walks CSV text field by field with RFC 4180 quoting
+      /// the text is classified 64 bytes at a time into bit masks of quotes and delimiters, a prefix xor of the quotes
+      /// gives the quoted regions, and the delimiters outside of them are the field and line ends
+      /// a cursor must start at the beginning of a line
+      /// </summary>
+      struct csv_cursor
+      {
+         const char* it{};
+         const char* end{};
+
+         csv_cursor(const char* it, const char* end) noexcept : it(it), end(end), next(it) {}
+
+         // the next unquoted ',' or '\n', end if there is none
+         const char* find_end() noexcept
+         {
+            if (structural) [[likely]] {
+               return base + std::countr_zero(structural);
+            }
+            return find_next_block();
+         }
+
+         // consumes the field end returned by find_end
+         void pop() noexcept { structural &= structural - 1; }
+
+         // moves it to the start of the next line
+         void skip_line() noexcept
+         {
+            while (true) {
+               // the rest of the classified block is walked by its delimiters
+               while (structural) {
+                  const char* p = base + std::countr_zero(structural);
+                  pop();
+                  if (*p == '\n') {
+                     it = p + 1;
+                     return;
+                  }
+               }
+               if (next >= end) {
+                  it = end;
+                  return;
+               }
+               // outside of quotes the rest of the line is searched for its newline without being classified
+               if (!quoted) {
+                  it = skip_csv_line(next, end);
+                  next = it;
+                  return;
+               }
+               classify();
+            }
+         }
+
+        private:
+         const char* base{};
+         const char* next{};
+         uint64_t structural{};
+         bool quoted{};
+
+         // classifies blocks until one holds a delimiter
+         const char* find_next_block() noexcept
+         {
+            while (!structural) {
+               if (next >= end) {
+                  return end;
+               }
+               classify();
+            }
+            return base + std::countr_zero(structural);
+         }
+
+         void classify() noexcept
+         {
+            const bool whole = end - next >= 64;
+            auto block = whole ? classify_csv_block(next) : classify_csv_tail(next, end);
+            if (block.quotes || quoted) {
+               // the carried quote state flips the whole block when it begins inside a quoted field
+               const uint64_t inside = prefix_xor(block.quotes) ^ (quoted ? ~uint64_t{} : 0);
+               quoted = inside >> 63;
+               block.delimiters &= ~inside;
+            }
+            structural = block.delimiters;
+            base = next;
+            next = whole ? next + 64 : end;
+         }
+      };
+
+      // splits the next field off the current line, returns false once the line has been consumed
+      // a delimiter that ends a line does not start another field, a quoted field is returned with its quotes
+      inline bool next_csv_field(csv_cursor& cursor, bool& eol, sv& field) noexcept
+      {
+         if (eol) {
+            return false;
+         }
+         const char* it = cursor.it;
+         const char* p = cursor.find_end();
+         eol = p == cursor.end || *p == '\n';
+         const char* last = p;
+         if (eol && last != it && last[-1] == '\r') {
+            --last;
+         }
+         field = sv{it, static_cast<size_t>(last - it)};
+         if (p == cursor.end) {
+            cursor.it = p;
+         }
+         else {
+            cursor.pop();
+            cursor.it = p + 1;
+         }
+         return !(eol && field.empty());
+      }
+
+      template <class T>
+      inline void reserve_more(T& container, const size_t n)
+      {
+         if constexpr (requires { container.reserve(n); }) {
+            container.reserve(container.size() + n);
+         }
+      }
+
+      // parses the values of one row wise line
+      template <class T>
+      inline void read_csv_line(csv_cursor& cursor, T& item)
+      {
+         sv field{};
+         bool eol = false;
+         // first value should be the name
+         next_csv_field(cursor, eol, field);
+         while (next_csv_field(cursor, eol, field)) {
+            typename T::value_type value;
+            parse_csv_value(field, value);
+            item.push_back(value);
+         }
+      }
+
+      // parses the column wise lines in [it, end), appending to each container of items
+      template <class Items>
+      inline void read_csv_rows(const char* it, const char* end, Items&& items)
+      {
+         static constexpr auto N = size_v<Items>;
+         csv_cursor cursor{it, end};
+         sv field{};
+         while (cursor.it < end) {
+            bool eol = false;
+            for_each<N>([&](auto I) {
+               auto& item = std::get<I>(items);
+               if (next_csv_field(cursor, eol, field)) {
+                  typename std::decay_t<decltype(item)>::value_type value;
+                  parse_csv_value(field, value);
+                  item.push_back(value);
+               }
+            });
+
+            // columns beyond the containers are ignored
+            if (!eol) {
+               cursor.skip_line();
+            }
+         }
+      }
+
+      // chunks below this many bytes are not worth a task
+      inline constexpr size_t min_csv_chunk = 1 << 16;
+
+      /// <summary>
+      /// splits [first, end) into at most n ranges that each begin at the start of a line
+      /// a newline inside a quoted field never ends a range: the quotes in each nominal range are counted in parallel,
+      /// which gives the quote state at every split point, and each split is then moved to the next line start
+      /// </summary>
+      inline std::vector<const char*> csv_chunks(pool& threads, const char* first, const char* end, size_t n)
+      {
+         const auto size = static_cast<size_t>(end - first);
+         n = std::max(std::min(n, size / min_csv_chunk), size_t{1});
+
+         std::vector<size_t> quotes(n);
+         threads.parallel_for(0, n, 1, [&](const size_t i) {
+            quotes[i] = static_cast<size_t>(std::count(first + size * i / n, first + size * (i + 1) / n, '"'));
+         });
+
+         std::vector<const char*> bounds{first};
+         bool quoted = false;
+         for (size_t i = 1; i < n; ++i) {
+            quoted ^= (quotes[i - 1] & 1) != 0;
+            const char* p = first + size * i / n;
+            bool inside = quoted;
+            if (p <= bounds.back()) {
+               // the previous split was moved past this one by a long quoted field
+               p = bounds.back();
+               inside = false;
+            }
+            else if (!inside && p[-1] == '\n') {
+               bounds.emplace_back(p);
+               continue;
+            }
+            for (; p < end; ++p) {
+               if (*p == '"') {
+                  inside = !inside;
+               }
+               else if (*p == '\n' && !inside) {
+                  ++p;
+                  break;
+               }
+            }
+            if (p > bounds.back() && p < end) {
+               bounds.emplace_back(p);
+            }
+         }
+         bounds.emplace_back(end);
+         return bounds;
+      }
+
+      // a struct whose members are columns
+      template <class T>
+      concept csv_struct = glaze_object_t<T>;
+
+      // a container of structs whose members are the values of a row
+      template <class T>
+      concept csv_struct_rows = !csv_struct<T> && requires(T container) {
+         requires glaze_object_t<typename T::value_type>;
+         container.emplace_back();
+      };
+
+      // reads a field into member I, scalar members are assigned and containers are appended to
+      template <class T, size_t I>
+      inline void read_csv_member(T& value, const sv field)
+      {
+         auto& member = get_member(value, glz::tuplet::get<1>(glz::tuplet::get<I>(meta_v<T>)));
+         using M = std::decay_t<decltype(member)>;
+         if constexpr (csv_value<M>) {
+            parse_csv_value(field, member);
+         }
+         else if constexpr (requires { member.push_back(typename M::value_type{}); } &&
+                            csv_value<typename M::value_type>) {
+            typename M::value_type x;
+            parse_csv_value(field, x);
+            member.push_back(x);
+         }
+         else {
+            throw std::runtime_error("csv | member type not supported");
+         }
+      }
+
+      template <class T>
+      using csv_member_reader = void (*)(T&, const sv);
+
+      template <class T, size_t... I>
+      constexpr auto make_csv_member_readers(std::index_sequence<I...>)
+      {
+         return std::array<csv_member_reader<T>, sizeof...(I)>{&read_csv_member<T, I>...};
+      }
+
+      // member reader for the column with this key, nullptr when T has no such member
+      template <class T>
+      inline csv_member_reader<T> find_csv_member(const sv key)
+      {
+         static constexpr auto N = std::tuple_size_v<meta_t<T>>;
+         static constexpr auto key_map = make_key_int_map<T>();
+         static constexpr auto readers = make_csv_member_readers<T>(std::make_index_sequence<N>{});
+         const auto trimmed = trim_csv_field(unquote_csv_field(key));
+         const auto member = key_map.find(frozen::string(trimmed));
+         return member == key_map.end() ? nullptr : readers[member->second];
+      }
+
+      // maps each column of a header line to a member, columns after the last mapped one are dropped
+      template <class T>
+      inline std::vector<csv_member_reader<T>> read_csv_header(csv_cursor& cursor)
+      {
+         std::vector<csv_member_reader<T>> columns;
+         sv field{};
+         bool eol = false;
+         while (next_csv_field(cursor, eol, field)) {
+            columns.emplace_back(find_csv_member<T>(field));
+         }
+         if (!eol) {
+            cursor.skip_line();
+         }
+         while (columns.size() && !columns.back()) {
+            columns.pop_back();
+         }
+         return columns;
+      }
+
+      // reads the fields of one line through the column readers, unmapped columns are not converted
+      template <class T>
+      inline void read_csv_mapped_line(csv_cursor& cursor, const std::vector<csv_member_reader<T>>& columns,
+                                       T& target)
+      {
+         sv field{};
+         bool eol = false;
+         for (const auto reader : columns) {
+            if (!next_csv_field(cursor, eol, field)) {
+               break;
+            }
+            if (reader) {
+               reader(target, field);
+            }
+         }
+         if (!eol) {
+            cursor.skip_line();
+         }
+      }
+
+      inline bool blank_csv_line(const char* it, const char* end) noexcept
+      {
+         return *it == '\n' || (*it == '\r' && (it + 1 == end || it[1] == '\n'));
+      }
+
+      template <class Items>
+      struct csv_columns;
+
+      template <class... Ts>
+      struct csv_columns<std::tuple<Ts...>>
+      {
+         using type = std::tuple<std::vector<typename std::decay_t<Ts>::value_type>...>;
+      };
    }
 
    template <class T>
-   inline void convert_value(std::stringstream& buffer, T& var) requires std::is_integral_v<T>
-   {
-       if constexpr (std::is_same_v<T, bool>) 
-       {
-           if (buffer.str().compare("1") == 0) {
-               var = true;
-           }
-           else if(buffer.str().compare("0") == 0) {
-               var = false;
-           }
-           else {
-               buffer.setstate(std::ios::failbit);
-           }
-       }
-       else {
-           buffer >> var;
-       }
-   }
-   
-   template<class T>
+   requires std::is_arithmetic_v<typename T::value_type>
    inline void read_csv(const std::string& buffer, T& container)
    {
-       std::stringstream convert(buffer);
        typename T::value_type temp;
-       convert_value(convert, temp);
-
-       if (!convert) {
-          throw std::runtime_error("csv | could not convert to type");
-       }
-
+       detail::parse_csv_value(buffer, temp);
        container.push_back(temp);
    }
 
+   /// <summary>
+   /// parses CSV text into a tuple of containers, values are appended to the containers
+   /// row wise: each line is a name followed by the values of one container
+   /// column wise: a header line followed by one value per container on each line
+   /// </summary>
    template <bool RowWise = true>
-   inline void read_csv(std::fstream& file, is_std_tuple auto&& items)
+   inline void read_csv(const sv buffer, auto&& items)
+   requires is_std_tuple<std::decay_t<decltype(items)>>
    {
        static constexpr auto N = size_v<decltype(items)>;
 
-       if constexpr (RowWise) 
-       {
-           // for each container
-           // read out contents of line
+       auto it = buffer.data();
+       const auto end = it + buffer.size();
 
+       if constexpr (RowWise)
+       {
+           detail::csv_cursor cursor{it, end};
            for_each<N>([&](auto I) {
                auto& item = std::get<I>(items);
 
-               std::string buffer; 
-               std::getline(file, buffer);
+               const auto line_end = detail::skip_csv_line(cursor.it, end);
+               detail::reserve_more(item, static_cast<size_t>(std::count(cursor.it, line_end, ',')));
+               detail::read_csv_line(cursor, item);
+           });
+       }
+       else
+       {
+           // first row should be names
+           it = detail::skip_csv_line(it, end);
+
+           const auto rows = static_cast<size_t>(std::count(it, end, '\n')) + 1;
+           for_each<N>([&](auto I) { detail::reserve_more(std::get<I>(items), rows); });
+
+           detail::read_csv_rows(it, end, items);
+       }
+   }
 
-               std::stringstream line(buffer);
+   /// <summary>
+   /// parses CSV text on a thread pool, the containers end up as with the serial read_csv
+   /// row wise: each line is parsed by its own task
+   /// column wise: the rows are split into chunks at line starts, each chunk is parsed into its own columns and the
+   /// columns are then appended in order
+   /// </summary>
+   template <bool RowWise = true>
+   inline void read_csv(const sv buffer, auto&& items, pool& threads)
+   requires is_std_tuple<std::decay_t<decltype(items)>>
+   {
+       static constexpr auto N = size_v<decltype(items)>;
+       using Items = std::decay_t<decltype(items)>;
 
-               // first value should be the name
-               std::string name;
-               std::getline(line, name, ',');
+       auto it = buffer.data();
+       const auto end = it + buffer.size();
 
-               for (std::string value; std::getline(line, value, ',');)
-               {
-                   read_csv(value, item);
-               }
+       if (threads.size() < 2 || buffer.size() < 2 * detail::min_csv_chunk) {
+           read_csv<RowWise>(buffer, items);
+           return;
+       }
+
+       if constexpr (RowWise)
+       {
+           std::array<const char*, N + 1> lines{it};
+           for (size_t i = 0; i < N; ++i) {
+               lines[i + 1] = detail::skip_csv_line(lines[i], end);
+           }
+           threads.parallel_for(0, N, 1, [&](const size_t i) {
+               for_each<N>([&](auto I) {
+                  if (I == i) {
+                     auto& item = std::get<I>(items);
+                     detail::reserve_more(item, static_cast<size_t>(std::count(lines[i], lines[i + 1], ',')));
+                     detail::csv_cursor cursor{lines[i], lines[i + 1]};
+                     detail::read_csv_line(cursor, item);
+                  }
+               });
            });
        }
        else
        {
            // first row should be names
-           std::string names;
-           std::getline(file, names);
+           it = detail::skip_csv_line(it, end);
 
-           for (std::string buffer; std::getline(file, buffer);)
-           {
-               std::stringstream line(buffer);
+           const auto bounds = detail::csv_chunks(threads, it, end, 4 * threads.size());
+           const auto n_chunks = bounds.size() - 1;
+           std::vector<typename detail::csv_columns<Items>::type> columns(n_chunks);
+           threads.parallel_for(0, n_chunks, 1, [&](const size_t i) {
+               auto& chunk = columns[i];
+               const auto rows = static_cast<size_t>(std::count(bounds[i], bounds[i + 1], '\n')) + 1;
+               for_each<N>([&](auto I) { std::get<I>(chunk).reserve(rows); });
+               detail::read_csv_rows(bounds[i], bounds[i + 1], chunk);
+           });
 
-               for_each<N>([&](auto I) {
-                   auto& item = std::get<I>(items);
+           for_each<N>([&](auto I) {
+               auto& item = std::get<I>(items);
+               size_t total = 0;
+               for (auto& chunk : columns) {
+                  total += std::get<I>(chunk).size();
+               }
+               detail::reserve_more(item, total);
+               for (auto& chunk : columns) {
+                  auto& column = std::get<I>(chunk);
+                  item.insert(item.end(), column.begin(), column.end());
+               }
+           });
+       }
+   }
 
-                   std::string value;
-                   if (std::getline(line, value, ',')) {
-                       read_csv(value, item);
+   /// <summary>
+   /// parses CSV text into a glz::meta object, columns are matched to members by name
+   /// a struct of containers is read row wise (a line per member) or column wise (a header line of member names)
+   /// a container of structs is always read column wise, with one struct per line
+   /// columns without a matching member are skipped without being converted
+   /// </summary>
+   template <bool RowWise = true, class T>
+   requires detail::csv_struct<std::decay_t<T>> || detail::csv_struct_rows<std::decay_t<T>>
+   inline void read_csv(const sv buffer, T&& value)
+   {
+       using V = std::decay_t<T>;
+
+       const auto end = buffer.data() + buffer.size();
+       detail::csv_cursor cursor{buffer.data(), end};
+
+       if constexpr (detail::csv_struct_rows<V>)
+       {
+           using Row = typename V::value_type;
+           const auto columns = detail::read_csv_header<Row>(cursor);
+           if constexpr (requires { value.reserve(size_t{}); }) {
+              value.reserve(value.size() + static_cast<size_t>(std::count(cursor.it, end, '\n')) + 1);
+           }
+           while (cursor.it < end) {
+               if (detail::blank_csv_line(cursor.it, end)) {
+                   cursor.skip_line();
+                   continue;
+               }
+               detail::read_csv_mapped_line(cursor, columns, value.emplace_back());
+           }
+       }
+       else if constexpr (RowWise)
+       {
+           sv field{};
+           while (cursor.it < end) {
+               bool eol = false;
+               if (!detail::next_csv_field(cursor, eol, field)) {
+                   continue;
+               }
+               const auto reader = detail::find_csv_member<V>(field);
+               if (!reader) {
+                   if (!eol) {
+                       cursor.skip_line();
                    }
-               });
+                   continue;
+               }
+               while (detail::next_csv_field(cursor, eol, field)) {
+                   reader(value, field);
+               }
+           }
+       }
+       else
+       {
+           const auto columns = detail::read_csv_header<V>(cursor);
+           while (cursor.it < end) {
+               detail::read_csv_mapped_line(cursor, columns, value);
            }
        }
    }
 
-   // TODO: change fstream to generic buffer
+   template <bool RowWise = true>
+   inline void read_csv(std::fstream& file, auto&& items)
+   requires is_std_tuple<std::decay_t<decltype(items)>>
+   {
+       const std::string buffer{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+       read_csv<RowWise>(sv{buffer}, items);
+   }
 
+   /// <summary>
+   /// reads file_name + ".csv", the file is memory mapped and parsed in place
+   /// </summary>
    template <bool RowWise = true, class... Args>
    inline void from_csv_file(const std::string_view file_name, Args&&... args)
    {
-       std::fstream file(std::string{ file_name } + ".csv", std::ios::in);
-      
-       read_csv<RowWise>(file, std::make_tuple(std::forward<Args>(args)...));
+       const mapped_file file(std::string{ file_name } + ".csv");
+
+       read_csv<RowWise>(sv{file.data(), file.size()}, std::forward_as_tuple(std::forward<Args>(args)...));
    }
-}
 
+   /// <summary>
+   /// reads file_name + ".csv" into a glz::meta object, matching columns to members by name
+   /// </summary>
+   template <bool RowWise = true, class T>
+   requires detail::csv_struct<std::decay_t<T>> || detail::csv_struct_rows<std::decay_t<T>>
+   inline void from_csv_file(const std::string_view file_name, T&& value)
+   {
+       const mapped_file file(std::string{ file_name } + ".csv");
 
+       read_csv<RowWise>(sv{file.data(), file.size()}, value);
+   }
+
+   /// <summary>
+   /// reads file_name + ".csv", parsing it on a thread pool
+   /// </summary>
+   template <bool RowWise = true, class... Args>
+   inline void from_csv_file(pool& threads, const std::string_view file_name, Args&&... args)
+   {
+       const mapped_file file(std::string{ file_name } + ".csv");
+
+       read_csv<RowWise>(sv{file.data(), file.size()}, std::forward_as_tuple(std::forward<Args>(args)...), threads);
+   }
+}
@@ -0,0 +1,182 @@
+// Distributed under the MIT license
+// Developed by Anyar Inc.
+
+#pragma once
+
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <variant>
+
+#include "glaze/csv/write.hpp"
+#include "glaze/record/recorder.hpp"
+
+namespace glz
+{
+   /// <summary>
+   /// streams the rows of a recorder to a column wise CSV file as the run progresses
+   /// rows are formatted on the recording thread into a front buffer, full batches are swapped with a back buffer that a
+   /// background thread writes and flushes, so file I/O stays off the recording thread
+   /// the header is written on the first update, channels registered after that are not streamed
+   /// </summary>
+   template <class Recorder>
+   struct csv_sink
+   {
+      // retain = false stops the recorder from keeping samples in memory while the sink is attached
+      csv_sink(Recorder& rec, const std::string& path, const size_t batch_rows = 1024, const bool retain = false)
+         : rec(rec), file(path, std::ios::binary | std::ios::trunc), batch_rows(std::max(batch_rows, size_t{1})),
+           previous_retain(rec.retain)
+      {
+         if (!file) {
+            throw std::runtime_error("csv_sink: could not open " + path);
+         }
+         front.resize(4096);
+         rec.retain = retain;
+         rec.on_update = [this] { append(); };
+         writer = std::thread([this] { write_batches(); });
+      }
+
+      csv_sink(const csv_sink&) = delete;
+      csv_sink& operator=(const csv_sink&) = delete;
+
+      ~csv_sink()
+      {
+         try {
+            close();
+         }
+         catch (...) {
+         }
+      }
+
+      // hands the rows formatted so far to the writer and waits until they are in the file
+      void flush()
+      {
+         submit();
+         std::unique_lock lock{mtx};
+         done_cv.wait(lock, [&] { return !pending; });
+      }
+
+      // flushes, stops the writer and detaches from the recorder
+      void close()
+      {
+         if (!writer.joinable()) {
+            return;
+         }
+         rec.on_update = {};
+         rec.retain = previous_retain;
+         flush();
+         {
+            std::lock_guard lock{mtx};
+            closing = true;
+         }
+         work_cv.notify_one();
+         writer.join();
+         file.close();
+      }
+
+      // rows formatted since the sink was attached
+      size_t size() const noexcept { return total_rows; }
+
+     private:
+      static constexpr opts Opts{.format = csv, .rowwise = false};
+
+      Recorder& rec;
+      std::ofstream file;
+      size_t batch_rows{};
+      bool previous_retain{};
+
+      size_t columns{};
+      bool header_written{};
+      size_t rows{};
+      size_t total_rows{};
+      context ctx{};
+
+      std::string front{};
+      size_t ix{};
+      std::string back{};
+
+      std::mutex mtx;
+      std::condition_variable work_cv;
+      std::condition_variable done_cv;
+      bool pending{};
+      bool closing{};
+      std::thread writer;
+
+      void append()
+      {
+         if (!header_written) {
+            header_written = true;
+            columns = rec.data.size();
+            for (size_t i = 0; i < columns; ++i) {
+               detail::write<csv>::op<Opts>(rec.data[i].first, ctx, front, ix);
+               if (i != columns - 1) {
+                  detail::dump<','>(front, ix);
+               }
+            }
+            detail::dump<'\n'>(front, ix);
+         }
+
+         for (size_t i = 0; i < columns; ++i) {
+            auto& [samples, ptr] = rec.data[i].second;
+            if (ptr) {
+               std::visit(
+                  [&](auto&& container) {
+                     using T = typename std::decay_t<decltype(container)>::value_type;
+                     detail::write<csv>::op<Opts>(*static_cast<const T*>(ptr), ctx, front, ix);
+                  },
+                  samples);
+            }
+            if (i != columns - 1) {
+               detail::dump<','>(front, ix);
+            }
+         }
+         detail::dump<'\n'>(front, ix);
+
+         ++total_rows;
+         if (++rows == batch_rows) {
+            submit();
+         }
+      }
+
+      // swaps the front buffer with the back buffer, waiting only if the previous batch is still being written
+      void submit()
+      {
+         if (ix == 0) {
+            return;
+         }
+         {
+            std::unique_lock lock{mtx};
+            done_cv.wait(lock, [&] { return !pending; });
+            const auto capacity = front.size();
+            front.resize(ix);
+            std::swap(front, back);
+            front.resize(std::max(front.capacity(), capacity));
+            pending = true;
+         }
+         work_cv.notify_one();
+         ix = 0;
+         rows = 0;
+      }
+
+      void write_batches()
+      {
+         std::unique_lock lock{mtx};
+         while (true) {
+            work_cv.wait(lock, [&] { return pending || closing; });
+            if (!pending) {
+               return;
+            }
+            lock.unlock();
+            file.write(back.data(), static_cast<std::streamsize>(back.size()));
+            file.flush();
+            back.clear();
+            lock.lock();
+            pending = false;
+            done_cv.notify_all();
+         }
+      }
+   };
+}
@@ -5,6 +5,10 @@
 
 #include <fstream>
 #include <sstream>
+#include <algorithm>
+#include <cstring>
+#include <utility>
+#include <vector>
 
 #include "fmt/format.h"
 #include "fmt/compile.h"
@@ -45,10 +49,31 @@ namespace glz
       requires str_t<T> || char_t<T>
       struct to_csv<T>
       {
+         // text with a delimiter, quote or line break is quoted with its quotes doubled (RFC 4180)
          template <auto Opts, class... Args>
          static void op(auto&& value, is_context auto&&, Args&&... args) noexcept
          {
-            dump(value, std::forward<Args>(args)...);
+            sv str{};
+            if constexpr (char_t<T>) {
+               str = sv{&value, 1};
+            }
+            else {
+               str = sv{value};
+            }
+            
+            if (str.find_first_of(",\"\r\n") == sv::npos) [[likely]] {
+               dump(str, args...);
+               return;
+            }
+            
+            dump<'"'>(args...);
+            for (auto q = str.find('"'); q != sv::npos; q = str.find('"')) {
+               dump(str.substr(0, q), args...);
+               dump<"\"\"">(args...);
+               str.remove_prefix(q + 1);
+            }
+            dump(str, args...);
+            dump<'"'>(args...);
          }
       };
       
@@ -83,6 +108,92 @@ namespace glz
          }
       };
       
+      // text of one column for a block of rows, the value of row r ends at ends[r]
+      struct csv_block_column
+      {
+         std::string text{};
+         std::vector<size_t> ends{};
+      };
+
+      // formats the next count values of a column with the number kernels, advancing the iterator
+      template <auto Opts, class It>
+      inline void format_csv_block(It& it, const size_t count, csv_block_column& column, is_context auto&& ctx)
+      {
+         column.ends.resize(count);
+         if (column.text.size() < 64 * count) {
+            column.text.resize(64 * count);
+         }
+         size_t ix = 0;
+         for (size_t r = 0; r < count; ++r, ++it) {
+            write<csv>::op<Opts>(*it, ctx, column.text, ix);
+            column.ends[r] = ix;
+         }
+      }
+
+      // rows per block, sized so that the formatted text of a block stays in cache
+      inline size_t csv_block_rows(const size_t n_columns) noexcept
+      {
+         return std::clamp<size_t>((size_t{1} << 16) / (24 * std::max<size_t>(n_columns, 1)), 16, 4096);
+      }
+
+      /// <summary>
+      /// column wise CSV rows written a block at a time
+      /// format_column(c, count, column) formats the next count values of column c, each column is walked sequentially
+      /// with its own number kernel, and the rows are then stitched together from the cached column text
+      /// </summary>
+      template <class... Args>
+      inline void write_csv_blocks(const size_t n_rows, std::vector<csv_block_column>& columns, auto&& format_column,
+                                   Args&&... args)
+      {
+         const size_t n_columns = columns.size();
+         if (n_columns == 0) {
+            return;
+         }
+         const size_t block = csv_block_rows(n_columns);
+         for (size_t first = 0; first < n_rows; first += block) {
+            const size_t count = std::min(block, n_rows - first);
+            size_t bytes = count * n_columns;
+            for (size_t c = 0; c < n_columns; ++c) {
+               format_column(c, count, columns[c]);
+               bytes += columns[c].ends[count - 1];
+            }
+
+            if constexpr (sizeof...(Args) == 2) {
+               auto&& [b, ix] = std::forward_as_tuple(args...);
+               if (ix + bytes > b.size()) {
+                  b.resize(std::max(b.size() * 2, ix + bytes));
+               }
+               auto* out = b.data() + ix;
+               for (size_t r = 0; r < count; ++r) {
+                  for (size_t c = 0; c < n_columns; ++c) {
+                     const auto& column = columns[c];
+                     const size_t start = r ? column.ends[r - 1] : 0;
+                     const size_t n = column.ends[r] - start;
+                     std::memcpy(out, column.text.data() + start, n);
+                     out += n;
+                     *out++ = (c == n_columns - 1) ? '\n' : ',';
+                  }
+               }
+               ix = static_cast<size_t>(out - b.data());
+            }
+            else {
+               for (size_t r = 0; r < count; ++r) {
+                  for (size_t c = 0; c < n_columns; ++c) {
+                     const auto& column = columns[c];
+                     const size_t start = r ? column.ends[r - 1] : 0;
+                     dump(sv{column.text.data() + start, column.ends[r] - start}, args...);
+                     if (c == n_columns - 1) {
+                        dump<'\n'>(args...);
+                     }
+                     else {
+                        dump<','>(args...);
+                     }
+                  }
+               }
+            }
+         }
+      }
+
       template <is_std_tuple T>
       struct to_csv<T>
       {
@@ -126,15 +237,18 @@ namespace glz
                dump<"\n">(args...);
                
                // write out columns of data
-               for (size_t i = 0; i < n; ++i) {
-                  for_each<N>([&](auto I) {
-                     write<csv>::op<Opts>(std::get<I>(data)[i], ctx, args...);
-                     if constexpr (I != N - 1) {
-                        dump<",">(args...);
-                     }
-                  });
-                  dump<"\n">(args...);
-               }
+               auto iterators = std::apply([](auto&... x) { return std::tuple{std::begin(x)...}; }, data);
+               std::vector<csv_block_column> columns(N);
+               write_csv_blocks(
+                  n, columns,
+                  [&](const size_t c, const size_t count, csv_block_column& column) {
+                     for_each<N>([&](auto I) {
+                        if (I == c) {
+                           format_csv_block<Opts>(std::get<I>(iterators), count, column, ctx);
+                        }
+                     });
+                  },
+                  args...);
             }
          }
       };
@@ -180,18 +294,20 @@ namespace glz
                }
                dump<"\n">(args...);
 
-               // write out columns of data
-               for (size_t i = 0; i < n; ++i) {
-                  I = 0;
-                  for (auto& [title, data] : map) {
-                     write<csv>::op<Opts>(data[i], ctx, args...);
-                     if (I != N - 1) {
-                        dump<",">(args...);
-                     }
-                     ++I;
-                  }
-                  dump<"\n">(args...);
+               // write out columns of data, the map nodes are visited once per block rather than once per value
+               using iterator = decltype(std::begin(map.begin()->second));
+               std::vector<iterator> iterators;
+               iterators.reserve(N);
+               for (auto& [title, data] : map) {
+                  iterators.emplace_back(std::begin(data));
                }
+               std::vector<csv_block_column> columns(N);
+               write_csv_blocks(
+                  n, columns,
+                  [&](const size_t c, const size_t count, csv_block_column& column) {
+                     format_csv_block<Opts>(iterators[c], count, column, ctx);
+                  },
+                  args...);
             }
          }
       };
@@ -208,7 +324,7 @@ namespace glz
             const auto N = map.size();
             
             // write out minimum dimensions
-            size_t n = std::numeric_limits<size_t>::max();
+            size_t n = map.empty() ? 0 : std::numeric_limits<size_t>::max();
             for (auto& [title, data] : map) {
                const auto m = variant_container_size(data.first);
                n = m < n ? m : n;
@@ -220,8 +336,9 @@ namespace glz
                    dump<",">(args...);
 
                     std::visit([&](auto&& arg) {
-                       for (size_t i = 0; i < n; ++i) {
-                          write<csv>::op<Opts>(arg[i], ctx, args...);
+                       auto it = arg.begin();
+                       for (size_t i = 0; i < n; ++i, ++it) {
+                          write<csv>::op<Opts>(*it, ctx, args...);
                           dump<",">(args...);
                        }
                     }, data.first);
@@ -239,18 +356,21 @@ namespace glz
                 }
                dump<"\n">(args...);
 
-                const auto n = map.size();
-                for (size_t i = 0; i < n; ++i) {
-                    I = 0;
-                    for (auto& [title, data] : map) {
-                       std::visit([&](auto&& arg) { write<csv>::op<Opts>(arg[i], ctx, args...); }, data.first);
-                        if (I != N - 1) {
-                           dump<",">(args...);
-                        }
-                        ++I;
-                    }
-                   dump<"\n">(args...);
+                // compressed channels decode sequentially, so each column keeps an iterator
+                using iterator_type = typename std::decay_t<decltype(rec)>::iterator_type;
+                std::vector<iterator_type> columns;
+                columns.reserve(N);
+                for (auto& [title, data] : map) {
+                   std::visit([&](auto&& arg) { columns.emplace_back(std::as_const(arg).begin()); }, data.first);
                 }
+                
+                std::vector<csv_block_column> text(N);
+                write_csv_blocks(
+                   n, text,
+                   [&](const size_t c, const size_t count, csv_block_column& column) {
+                      std::visit([&](auto&& it) { format_csv_block<Opts>(it, count, column, ctx); }, columns[c]);
+                   },
+                   args...);
             }
          }
       };
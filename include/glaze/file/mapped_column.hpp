@@ -0,0 +1,268 @@
+// Glaze Library
+// For the license information refer to glaze.hpp
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "glaze/file/mapped_file.hpp"
+
+namespace glz
+{
+   /// <summary>
+   /// column of values written straight into a memory mapped file, so a column can be larger than RAM
+   /// the file grows by whole extents, appending is a store into the mapping except when an extent is added
+   /// on close the file is trimmed to the values written, leaving a raw array of T that glz::column_span can view
+   /// use it as a recorder channel with glz::recorder<glz::mapped_column<double>> and set the recorder's column_directory
+   /// </summary>
+   template <class T>
+   struct mapped_column
+   {
+      static_assert(std::is_trivially_copyable_v<T>, "mapped_column: values are stored as raw bytes");
+
+      using value_type = T;
+      using size_type = size_t;
+      using difference_type = std::ptrdiff_t;
+      using reference = T&;
+      using const_reference = const T&;
+      using iterator = T*;
+      using const_iterator = const T*;
+
+      static constexpr size_t default_extent = size_t(64) << 20;
+
+      // a column without a file holds no values, reading into it throws
+      mapped_column() = default;
+
+      // creates or truncates path, extent_bytes is how much the file grows at a time
+      explicit mapped_column(const std::string& path, const size_t extent_bytes = default_extent)
+         : path(path), extent(std::max(extent_bytes / sizeof(T), size_t{1}))
+      {
+#ifdef _WIN32
+         file = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS,
+                            FILE_ATTRIBUTE_NORMAL, nullptr);
+         if (file == INVALID_HANDLE_VALUE) {
+            throw std::runtime_error("mapped_column: could not create " + path);
+         }
+#else
+         fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+         if (fd < 0) {
+            throw std::runtime_error("mapped_column: could not create " + path);
+         }
+#endif
+      }
+
+      mapped_column(const mapped_column&) = delete;
+      mapped_column& operator=(const mapped_column&) = delete;
+
+      mapped_column(mapped_column&& other) noexcept { swap(other); }
+
+      mapped_column& operator=(mapped_column&& other) noexcept
+      {
+         if (this != &other) {
+            close();
+            swap(other);
+         }
+         return *this;
+      }
+
+      ~mapped_column()
+      {
+         try {
+            close();
+         }
+         catch (...) {
+         }
+      }
+
+      template <class... Args>
+      T& emplace_back(Args&&... args)
+      {
+         if (count == capacity) [[unlikely]] {
+            grow(capacity + extent);
+         }
+         return *new (values + count++) T(std::forward<Args>(args)...);
+      }
+
+      void push_back(const T& value) { emplace_back(value); }
+
+      void resize(const size_t n)
+      {
+         if (n > capacity) {
+            grow((n + extent - 1) / extent * extent);
+         }
+         if (n > count) {
+            std::memset(static_cast<void*>(values + count), 0, (n - count) * sizeof(T));
+         }
+         count = n;
+      }
+
+      void clear() noexcept { count = 0; }
+
+      size_t size() const noexcept { return count; }
+      bool empty() const noexcept { return count == 0; }
+
+      T* data() noexcept { return values; }
+      const T* data() const noexcept { return values; }
+
+      T& operator[](const size_t i) noexcept { return values[i]; }
+      const T& operator[](const size_t i) const noexcept { return values[i]; }
+
+      T& front() noexcept { return values[0]; }
+      const T& front() const noexcept { return values[0]; }
+      T& back() noexcept { return values[count - 1]; }
+      const T& back() const noexcept { return values[count - 1]; }
+
+      T* begin() noexcept { return values; }
+      T* end() noexcept { return values + count; }
+      const T* begin() const noexcept { return values; }
+      const T* end() const noexcept { return values + count; }
+
+      std::span<const T> span() const noexcept { return {values, count}; }
+
+      bool operator==(const mapped_column& other) const { return std::equal(begin(), end(), other.begin(), other.end()); }
+
+      const std::string& file_path() const noexcept { return path; }
+
+      // writes the mapped pages to the file
+      void flush()
+      {
+         if (!values) {
+            return;
+         }
+#ifdef _WIN32
+         FlushViewOfFile(values, 0);
+#else
+         ::msync(values, capacity * sizeof(T), MS_SYNC);
+#endif
+      }
+
+      // unmaps the column and trims the file to the values written, after which the column is empty
+      void close()
+      {
+#ifdef _WIN32
+         if (file == INVALID_HANDLE_VALUE) {
+            return;
+         }
+         unmap();
+         LARGE_INTEGER end{};
+         end.QuadPart = static_cast<LONGLONG>(count * sizeof(T));
+         const bool trimmed = SetFilePointerEx(file, end, nullptr, FILE_BEGIN) && SetEndOfFile(file);
+         CloseHandle(file);
+         file = INVALID_HANDLE_VALUE;
+#else
+         if (fd < 0) {
+            return;
+         }
+         unmap();
+         const bool trimmed = ::ftruncate(fd, static_cast<off_t>(count * sizeof(T))) == 0;
+         ::close(fd);
+         fd = -1;
+#endif
+         capacity = 0;
+         count = 0;
+         if (!trimmed) {
+            throw std::runtime_error("mapped_column: could not trim " + path);
+         }
+      }
+
+     private:
+      std::string path{};
+      size_t extent{default_extent / sizeof(T)};
+      T* values{};
+      size_t count{};
+      size_t capacity{};
+#ifdef _WIN32
+      HANDLE file = INVALID_HANDLE_VALUE;
+      HANDLE mapping{};
+#else
+      int fd = -1;
+#endif
+
+      void swap(mapped_column& other) noexcept
+      {
+         std::swap(path, other.path);
+         std::swap(extent, other.extent);
+         std::swap(values, other.values);
+         std::swap(count, other.count);
+         std::swap(capacity, other.capacity);
+#ifdef _WIN32
+         std::swap(file, other.file);
+         std::swap(mapping, other.mapping);
+#else
+         std::swap(fd, other.fd);
+#endif
+      }
+
+      void unmap() noexcept
+      {
+#ifdef _WIN32
+         if (values) UnmapViewOfFile(values);
+         if (mapping) CloseHandle(mapping);
+         mapping = nullptr;
+#else
+         if (values) ::munmap(values, capacity * sizeof(T));
+#endif
+         values = nullptr;
+      }
+
+      // extends the file to n values and maps it again, the values written so far stay in the file
+      // the old view is only replaced once the new one is mapped, so a failure leaves the column as it was
+      void grow(const size_t n)
+      {
+         const size_t bytes = n * sizeof(T);
+#ifdef _WIN32
+         if (file == INVALID_HANDLE_VALUE) {
+            throw std::runtime_error("mapped_column: no file to grow");
+         }
+         HANDLE grown = CreateFileMappingA(file, nullptr, PAGE_READWRITE, static_cast<DWORD>(uint64_t(bytes) >> 32),
+                                           static_cast<DWORD>(bytes & 0xffffffff), nullptr);
+         if (!grown) {
+            throw std::runtime_error("mapped_column: could not grow " + path);
+         }
+         void* p = MapViewOfFile(grown, FILE_MAP_ALL_ACCESS, 0, 0, bytes);
+         if (!p) {
+            CloseHandle(grown);
+            throw std::runtime_error("mapped_column: could not map " + path);
+         }
+         unmap();
+         mapping = grown;
+#else
+         if (fd < 0) {
+            throw std::runtime_error("mapped_column: no file to grow");
+         }
+         // the current view stays valid while the file grows
+         if (::ftruncate(fd, static_cast<off_t>(bytes)) != 0) {
+            throw std::runtime_error("mapped_column: could not grow " + path);
+         }
+         void* p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+         if (p == MAP_FAILED) {
+            throw std::runtime_error("mapped_column: could not map " + path);
+         }
+         unmap();
+#endif
+         values = static_cast<T*>(p);
+         capacity = n;
+      }
+   };
+
+   /// <summary>
+   /// views a column file written by glz::mapped_column as values, without copying
+   /// </summary>
+   template <class T>
+   std::span<const T> column_span(const mapped_file& file)
+   {
+      static_assert(std::is_trivially_copyable_v<T>, "column_span: values are stored as raw bytes");
+      if (file.size() % sizeof(T) != 0) {
+         throw std::runtime_error("column_span: file size is not a whole number of values");
+      }
+      return {reinterpret_cast<const T*>(file.data()), file.size() / sizeof(T)};
+   }
+}
@@ -0,0 +1,135 @@
+// Glaze Library
+// For the license information refer to glaze.hpp
+
+#pragma once
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace glz
+{
+   /// <summary>
+   /// read only memory mapping of a whole file
+   /// pages are loaded by the operating system as they are touched, so seeking into large files reads only what is used
+   /// </summary>
+   struct mapped_file
+   {
+      mapped_file() = default;
+
+      explicit mapped_file(const std::string& path)
+      {
+#ifdef _WIN32
+         file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL, nullptr);
+         if (file == INVALID_HANDLE_VALUE) {
+            throw std::runtime_error("mapped_file: could not open " + path);
+         }
+         LARGE_INTEGER file_size{};
+         GetFileSizeEx(file, &file_size);
+         n = static_cast<size_t>(file_size.QuadPart);
+         if (n > 0) {
+            mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (!mapping) {
+               close();
+               throw std::runtime_error("mapped_file: could not map " + path);
+            }
+            ptr = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+            if (!ptr) {
+               close();
+               throw std::runtime_error("mapped_file: could not map " + path);
+            }
+         }
+#else
+         fd = ::open(path.c_str(), O_RDONLY);
+         if (fd < 0) {
+            throw std::runtime_error("mapped_file: could not open " + path);
+         }
+         struct stat st
+         {};
+         ::fstat(fd, &st);
+         n = static_cast<size_t>(st.st_size);
+         if (n > 0) {
+            void* p = ::mmap(nullptr, n, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p == MAP_FAILED) {
+               close();
+               throw std::runtime_error("mapped_file: could not map " + path);
+            }
+            ptr = static_cast<const char*>(p);
+         }
+#endif
+      }
+
+      mapped_file(const mapped_file&) = delete;
+      mapped_file& operator=(const mapped_file&) = delete;
+
+      mapped_file(mapped_file&& other) noexcept { swap(other); }
+
+      mapped_file& operator=(mapped_file&& other) noexcept
+      {
+         if (this != &other) {
+            close();
+            swap(other);
+         }
+         return *this;
+      }
+
+      ~mapped_file() { close(); }
+
+      const char* data() const noexcept { return ptr; }
+      size_t size() const noexcept { return n; }
+      bool empty() const noexcept { return n == 0; }
+
+      void close() noexcept
+      {
+#ifdef _WIN32
+         if (ptr) UnmapViewOfFile(ptr);
+         if (mapping) CloseHandle(mapping);
+         if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+         mapping = nullptr;
+         file = INVALID_HANDLE_VALUE;
+#else
+         if (ptr) ::munmap(const_cast<char*>(ptr), n);
+         if (fd >= 0) ::close(fd);
+         fd = -1;
+#endif
+         ptr = nullptr;
+         n = 0;
+      }
+
+     private:
+      const char* ptr{};
+      size_t n{};
+#ifdef _WIN32
+      HANDLE file = INVALID_HANDLE_VALUE;
+      HANDLE mapping{};
+#else
+      int fd = -1;
+#endif
+
+      void swap(mapped_file& other) noexcept
+      {
+         std::swap(ptr, other.ptr);
+         std::swap(n, other.n);
+#ifdef _WIN32
+         std::swap(file, other.file);
+         std::swap(mapping, other.mapping);
+#else
+         std::swap(fd, other.fd);
+#endif
+      }
+   };
+}
@@ -3,149 +3,283 @@
 
 #pragma once
 
-// TODO: this only handles /**/ style comments
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+#include "glaze/util/string_view.hpp"
+#include "glaze/util/swar.hpp"
 
 namespace glz
 {
    namespace detail
    {
-      enum class general_state : uint32_t {
-         NORMAL,
-         ESCAPED,
-         STRING,
-         BEFORE_ASTERISK,
-         COMMENT,
-         BEFORE_FSLASH
+      inline sv text_view(const auto& in) noexcept
+      {
+         if constexpr (sv_convertible<decltype(in)>) {
+            return sv{in};
+         }
+         else {
+            return sv{in.data(), in.size()};
+         }
+      }
+
+      // Output writer that grows the buffer geometrically and copies whole runs
+      template <class Buffer>
+      struct text_writer
+      {
+         Buffer& out;
+         size_t ix{};
+
+         void reserve(const size_t n)
+         {
+            if (ix + n > out.size()) [[unlikely]] {
+               out.resize(std::max(out.size() * 2, ix + n));
+            }
+         }
+
+         void put(const char c)
+         {
+            reserve(1);
+            out[ix] = c;
+            ++ix;
+         }
+
+         void put(const char* first, const size_t n)
+         {
+            reserve(n);
+            std::memcpy(out.data() + ix, first, n);
+            ix += n;
+         }
+
+         void put(const char* first, const char* last) { put(first, static_cast<size_t>(last - first)); }
       };
 
-      inline void prettify_normal_state(const char c, auto& out, uint32_t& indent, auto nl,
-                                 general_state& state) noexcept
+      // copies a JSON string starting at its opening quote, returns the position past the closing quote
+      inline const char* copy_string(const char* it, const char* end, auto& w)
       {
-         switch (c) {
-         case ',':
-            out += c;
-            nl();
+         const auto start = it;
+         ++it;
+         while (true) {
+            it = find_first_of<false, '"', '\\'>(it, end);
+            if (it == end) [[unlikely]] {
+               break;
+            }
+            if (*it == '\\') {
+               it = std::min(it + 2, end);
+               continue;
+            }
+            ++it;
             break;
-         case '[':
-            out += c;
-            ++indent;
-            nl();
+         }
+         w.put(start, it);
+         return it;
+      }
+
+      // returns the end of a comment starting at '/', comments are /* */ or run to the end of the line
+      inline const char* comment_end(const char* it, const char* end, bool& line_comment) noexcept
+      {
+         line_comment = false;
+         if (it + 1 == end) {
+            return end;
+         }
+         if (it[1] == '/') {
+            line_comment = true;
+            return find_first_of<false, '\n'>(it, end);
+         }
+         it += 2;
+         while (true) {
+            it = find_first_of<false, '*'>(it, end);
+            if (it == end) {
+               return end;
+            }
+            ++it;
+            if (it != end && *it == '/') {
+               return it + 1;
+            }
+         }
+      }
+
+      template <char C>
+      inline constexpr auto indent_block = [] {
+         std::array<char, 256> arr{};
+         arr.fill(C);
+         return arr;
+      }();
+   }
+
+   /// <summary>
+   /// pretty print a JSON string
+   /// runs of characters between structural characters are copied whole, with strings scanned eight bytes at a time
+   /// </summary>
+   inline void prettify(const auto& in, auto& out, const bool tabs = false, const uint32_t indent_size = 3) noexcept
+   {
+      using namespace detail;
+
+      const auto str = text_view(in);
+      auto it = str.data();
+      const auto end = it + str.size();
+
+      // output is appended to any existing content
+      const auto start = out.size();
+      out.resize(start + str.size() + str.size() / 2 + 64);
+      text_writer<std::decay_t<decltype(out)>> w{out, start};
+
+      const char* indent_chars = tabs ? indent_block<'\t'>.data() : indent_block<' '>.data();
+      const size_t indent_width = tabs ? 1 : indent_size;
+      int64_t indent{};
+
+      // newlines are written lazily so that closing brackets can dedent them and empty containers stay as [] or {}
+      bool newline = false;
+      bool opened = false;
+      auto flush = [&] {
+         opened = false;
+         if (newline) {
+            newline = false;
+            w.put('\n');
+            auto n = static_cast<size_t>(std::max(indent, int64_t{0})) * indent_width;
+            while (n > 0) {
+               const auto k = std::min(n, size_t{256});
+               w.put(indent_chars, k);
+               n -= k;
+            }
+         }
+      };
+
+      while (it < end) {
+         const auto next = find_first_of<true, ',', '[', ']', '{', '}', ':', '"', '/'>(it, end);
+         if (next != it) {
+            flush();
+            w.put(it, next);
+            it = next;
+         }
+         if (it == end) {
             break;
-         case ']':
-            --indent;
-            nl();
-            out += c;
+         }
+
+         switch (*it) {
+         case ',':
+            flush();
+            w.put(',');
+            newline = true;
+            ++it;
             break;
+         case '[':
          case '{':
-            out += c;
+            flush();
+            w.put(*it);
             ++indent;
-            nl();
+            newline = true;
+            opened = true;
+            ++it;
             break;
+         case ']':
          case '}':
             --indent;
-            nl();
-            out += c;
-            break;
-         case '\\':
-            out += c;
-            state = general_state::ESCAPED;
-            break;
-         case '\"':
-            out += c;
-            state = general_state::STRING;
-            break;
-         case '/':
-            out += " /";
-            state = general_state::BEFORE_ASTERISK;
-            break;
-         case ':':
-            out += ": ";
-            break;
-         case ' ':
-         case '\n':
-         case '\r':
-         case '\t':
-            break;
-         default:
-            out += c;
-            break;
-         }
-      }
-
-      inline void prettify_other_states(const char c, general_state& state) noexcept
-      {
-         using enum general_state;
-         switch (state) {
-         case ESCAPED:
-            state = NORMAL;
-            break;
-         case STRING:
-            if (c == '"') {
-               state = NORMAL;
+            if (opened) {
+               newline = false;
             }
+            else {
+               newline = true;
+            }
+            flush();
+            w.put(*it);
+            ++it;
             break;
-         case BEFORE_ASTERISK:
-            state = COMMENT;
+         case ':':
+            w.put(": ", 2);
+            ++it;
             break;
-         case COMMENT:
-            if (c == '*') {
-               state = BEFORE_FSLASH;
-            }
+         case '"':
+            flush();
+            it = copy_string(it, end, w);
             break;
-         case BEFORE_FSLASH:
-            if (c == '/') {
-               state = NORMAL;
+         case '/': {
+            bool line_comment{};
+            const auto last = comment_end(it, end, line_comment);
+            const bool line_start = newline;
+            flush();
+            if (!line_start) {
+               w.put(' ');
             }
-            else {
-               state = COMMENT;
+            w.put(it, last);
+            it = last;
+            if (line_comment) {
+               newline = true;
             }
             break;
+         }
          default:
+            // whitespace is regenerated
+            ++it;
             break;
          }
       }
+
+      out.resize(w.ix);
    }
 
    /// <summary>
-   /// pretty print a JSON string
+   /// allocating version of prettify
    /// </summary>
-   inline void prettify(const auto& in, auto& out, const bool tabs = false,
-                 const uint32_t indent_size = 3) noexcept
+   inline std::string prettify(const auto& in, const bool tabs = false, const uint32_t indent_size = 3) noexcept
    {
-      out.reserve(in.size());
-      uint32_t indent{};
+      std::string out{};
+      prettify(in, out, tabs, indent_size);
+      return out;
+   }
+
+   /// <summary>
+   /// remove all whitespace and comments outside of strings from a JSON string
+   /// </summary>
+   inline void minify(const auto& in, auto& out) noexcept
+   {
+      using namespace detail;
+
+      const auto str = text_view(in);
+      auto it = str.data();
+      const auto end = it + str.size();
 
-      auto nl = [&]() {
-         out += "\n";
+      // output is appended to any existing content
+      const auto start = out.size();
+      out.resize(start + str.size());
+      text_writer<std::decay_t<decltype(out)>> w{out, start};
 
-         for (uint32_t i = 0; i < indent * (tabs ? 1 : indent_size); i++) {
-            out += tabs ? "\t" : " ";
+      while (it < end) {
+         const auto next = find_first_of<true, '"', '/'>(it, end);
+         w.put(it, next);
+         it = next;
+         if (it == end) {
+            break;
          }
-      };
-      
-      using namespace detail;
-      general_state state{general_state::NORMAL};
 
-      for (auto c : in) {
-         if (state == general_state::NORMAL) {
-            prettify_normal_state(c, out, indent, nl, state);
-            continue;
+         switch (*it) {
+         case '"':
+            it = copy_string(it, end, w);
+            break;
+         case '/': {
+            bool line_comment{};
+            it = comment_end(it, end, line_comment);
+            break;
          }
-         else {
-            out += c;
-            prettify_other_states(c, state);
+         default:
+            ++it;
+            break;
          }
       }
+
+      out.resize(w.ix);
    }
-   
+
    /// <summary>
-   /// allocating version of prettify
+   /// allocating version of minify
    /// </summary>
-   inline std::string prettify(const auto& in, const bool tabs = false,
-                 const uint32_t indent_size = 3) noexcept
+   inline std::string minify(const auto& in) noexcept
    {
       std::string out{};
-      prettify(in, out, tabs, indent_size);
+      minify(in, out);
       return out;
    }
 }
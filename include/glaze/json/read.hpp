@@ -526,6 +526,16 @@ namespace glz
          }
       };
       
+      template <encoding E, class T>
+      struct from_json<encoded<E, T>>
+      {
+         template <auto Opts>
+         static void op(auto&& value, is_context auto&& ctx, auto&& it, auto&& end)
+         {
+            read<json>::op<Opts>(value.value, ctx, it, end);
+         }
+      };
+      
       template <class T>
       struct from_json<includer<T>>
       {
@@ -223,18 +223,16 @@ namespace glz
          pool.wait();
       }
       
+      // every state gets its own copy of f, as with the generator overload, the first exception thrown by f is rethrown
       template <class T> requires nano::ranges::range<T>
       void run_study(T& states, auto&& f)
       {
          glz::pool pool{};
-         const auto n = states.size();
-         for (size_t i = 0; i < n; ++i)
-         {
-            pool.emplace_back([=, state = states[i]](const auto) {
-               f(std::move(state), i);
-            });
-         }
-         pool.wait();
+         pool.parallel_for(0, states.size(), 1, [&](const size_t i) {
+            auto state = states[i];
+            auto func = f;
+            func(std::move(state), i);
+         });
       }
 
       struct random_param
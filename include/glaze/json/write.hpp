@@ -19,6 +19,7 @@
 #include "glaze/util/to_chars.hpp"
 #include "glaze/util/itoa.hpp"
 #include "glaze/core/write_chars.hpp"
+#include "glaze/core/write_parallel.hpp"
 
 namespace glz
 {
@@ -213,6 +214,23 @@ namespace glz
             }();
             
             if (!is_empty) {
+               if constexpr (parallel_writable<Opts, T>) {
+                  if (use_parallel(value, ctx)) {
+                     auto write_element = [](auto&& it, const size_t index, auto&& c, auto&& b, auto&& ix) {
+                        if (index > 0) {
+                           dump<','>(b, ix);
+                        }
+                        write<json>::op<serial<Opts>()>(*it, c, b, ix);
+                     };
+                     const auto chunks = write_chunks(value, ctx, write_element);
+                     for (auto& chunk : chunks) {
+                        dump(chunk, std::forward<Args>(args)...);
+                     }
+                     dump<']'>(std::forward<Args>(args)...);
+                     return;
+                  }
+               }
+               
                auto it = value.begin();
                write<json>::op<Opts>(*it, ctx, std::forward<Args>(args)...);
                ++it;
@@ -234,6 +252,38 @@ namespace glz
          {
             dump<'{'>(std::forward<Args>(args)...);
             if (!value.empty()) {
+               if constexpr (parallel_writable<Opts, T>) {
+                  if (use_parallel(value, ctx)) {
+                     auto write_element = [](auto&& it, const size_t index, auto&& c, auto&& b, auto&& ix) {
+                        static constexpr auto S = serial<Opts>();
+                        if (index > 0) {
+                           using Value = std::decay_t<decltype(it->second)>;
+                           if constexpr (nullable_t<Value> && Opts.skip_null_members) {
+                              if (!bool(it->second)) return;
+                           }
+                           dump<','>(b, ix);
+                        }
+                        using Key = decltype(it->first);
+                        if constexpr (str_t<Key> || char_t<Key>) {
+                           write<json>::op<S>(it->first, c, b, ix);
+                        }
+                        else {
+                           dump<'"'>(b, ix);
+                           write<json>::op<S>(it->first, c, b, ix);
+                           dump<'"'>(b, ix);
+                        }
+                        dump<':'>(b, ix);
+                        write<json>::op<S>(it->second, c, b, ix);
+                     };
+                     const auto chunks = write_chunks(value, ctx, write_element);
+                     for (auto& chunk : chunks) {
+                        dump(chunk, std::forward<Args>(args)...);
+                     }
+                     dump<'}'>(std::forward<Args>(args)...);
+                     return;
+                  }
+               }
+               
                auto it = value.cbegin();
                auto write_pair = [&] {
                   using Key = decltype(it->first);
@@ -330,6 +380,16 @@ namespace glz
          }
       };
       
+      template <encoding E, class T>
+      struct to_json<encoded<E, T>>
+      {
+         template <auto Opts, class... Args>
+         static void op(auto&& value, is_context auto&& ctx, Args&&... args) noexcept
+         {
+            write<json>::op<Opts>(value.value, ctx, std::forward<Args>(args)...);
+         }
+      };
+      
       template <class T>
       struct to_json<includer<T>>
       {
@@ -0,0 +1,294 @@
+// Glaze Library
+// For the license information refer to glaze.hpp
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <concepts>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include "glaze/record/recorder.hpp"
+
+namespace glz
+{
+   namespace detail
+   {
+      // one channel of a producer: the slots of its queue, the variable it records and the merged channel it feeds
+      template <class Container>
+      struct producer_column
+      {
+         using value_type = typename Container::value_type;
+
+         std::unique_ptr<value_type[]> slots{};
+         const value_type* source{};
+         Container* target{};
+         // value at the newest merged tick, repeated for ticks this producer did not publish
+         value_type latest{};
+      };
+
+      // keeps the queue indices written by different threads on separate cache lines
+      inline constexpr size_t cache_line = 64;
+   }
+
+   /// <summary>
+   /// records channels owned by several threads into one recorder
+   /// each thread registers its channels with its own producer and calls producer.update(tick), which copies the
+   /// channel values into the producer's single producer single consumer queue, without a lock
+   /// a background collector merges the queues by tick into the recorder `merged`, one row per tick, with the tick of
+   /// each row in `ticks`, a producer that did not publish a tick repeats its previous values for that row
+   /// a row is merged once every producer has published up to its tick or has called finish(), or when the recorder
+   /// is stopped
+   /// </summary>
+   template <class... Ts>
+   struct concurrent_recorder
+   {
+      using recorder_type = recorder<Ts...>;
+
+      struct producer
+      {
+         producer(concurrent_recorder& owner, const size_t capacity)
+            : owner(owner), capacity(capacity), ticks(new uint64_t[capacity])
+         {}
+
+         producer(const producer&) = delete;
+         producer& operator=(const producer&) = delete;
+
+         struct assigner
+         {
+            producer& self;
+            sv name{};
+
+            template <class T>
+            void operator=(T& ref)
+            {
+               self.add(name, ref);
+            }
+         };
+
+         // channels are registered before the recorder is started
+         assigner operator[](const sv name) { return {*this, name}; }
+
+         /// <summary>
+         /// publishes the current values of this producer's channels at tick
+         /// ticks must increase from one update to the next, waits only while the queue is full
+         /// </summary>
+         void update(const uint64_t tick)
+         {
+            const auto h = head.load(std::memory_order_relaxed);
+            if (h - cached_tail == capacity) [[unlikely]] {
+               while (h - (cached_tail = tail.load(std::memory_order_acquire)) == capacity) {
+                  std::this_thread::yield();
+               }
+            }
+            const auto slot = h & (capacity - 1);
+            ticks[slot] = tick;
+            std::apply(
+               [&](auto&... group) {
+                  (
+                     [&] {
+                        for (auto& column : group) {
+                           column.slots[slot] = *column.source;
+                        }
+                     }(),
+                     ...);
+               },
+               columns);
+            head.store(h + 1, std::memory_order_release);
+         }
+
+         /// <summary>
+         /// marks this producer as done publishing, so the rows after its last tick are merged without waiting for it
+         /// and repeat its last values, update must not be called afterwards
+         /// </summary>
+         void finish() noexcept { finished.store(true, std::memory_order_release); }
+
+        private:
+         friend struct concurrent_recorder;
+
+         concurrent_recorder& owner;
+         const size_t capacity{};
+         std::unique_ptr<uint64_t[]> ticks{};
+         std::tuple<std::vector<detail::producer_column<typename detail::recorder_storage<Ts>::type>>...> columns{};
+
+         // written by the producer
+         alignas(detail::cache_line) std::atomic<size_t> head{};
+         size_t cached_tail{};
+         std::atomic<bool> finished{};
+         // written by the collector
+         alignas(detail::cache_line) std::atomic<size_t> tail{};
+         size_t cached_head{};
+
+         template <class T>
+         void add(const sv name, T& ref)
+         {
+            if (owner.collector.joinable()) {
+               throw std::runtime_error("concurrent_recorder: channels must be registered before start()");
+            }
+            auto& data = owner.merged.data;
+            detail::recorder_assigner<std::decay_t<decltype(data)>>{data, name, owner.merged.ring_capacity,
+                                                                   owner.merged.column_directory} = ref;
+            // the merged channel is filled by the collector, not by merged.update()
+            auto& [samples, source] = data.back().second;
+            source = nullptr;
+            std::visit(
+               [&](auto& container) {
+                  using Container = std::decay_t<decltype(container)>;
+                  if constexpr (std::same_as<typename Container::value_type, T>) {
+                     std::get<std::vector<detail::producer_column<Container>>>(columns).push_back(
+                        {std::make_unique<T[]>(capacity), &ref, &container});
+                  }
+               },
+               samples);
+         }
+
+         // called by the collector
+         bool available() noexcept
+         {
+            const auto t = tail.load(std::memory_order_relaxed);
+            if (t == cached_head) {
+               cached_head = head.load(std::memory_order_acquire);
+            }
+            return t != cached_head;
+         }
+
+         // finished and everything it published has been merged
+         bool drained() noexcept { return finished.load(std::memory_order_acquire) && !available(); }
+
+         uint64_t front_tick() const noexcept { return ticks[tail.load(std::memory_order_relaxed) & (capacity - 1)]; }
+
+         void pop() noexcept
+         {
+            const auto t = tail.load(std::memory_order_relaxed);
+            const auto slot = t & (capacity - 1);
+            std::apply(
+               [&](auto&... group) {
+                  (
+                     [&] {
+                        for (auto& column : group) {
+                           column.latest = column.slots[slot];
+                        }
+                     }(),
+                     ...);
+               },
+               columns);
+            tail.store(t + 1, std::memory_order_release);
+         }
+
+         void append() const
+         {
+            std::apply(
+               [&](auto&... group) {
+                  (
+                     [&] {
+                        for (auto& column : group) {
+                           column.target->emplace_back(column.latest);
+                        }
+                     }(),
+                     ...);
+               },
+               columns);
+         }
+      };
+
+      // queue_capacity is the number of ticks each producer can publish ahead of the collector, rounded up to a power
+      // of two
+      explicit concurrent_recorder(const size_t queue_capacity = 4096)
+         : queue_capacity(std::bit_ceil(std::max(queue_capacity, size_t{2})))
+      {}
+
+      concurrent_recorder(const concurrent_recorder&) = delete;
+      concurrent_recorder& operator=(const concurrent_recorder&) = delete;
+
+      ~concurrent_recorder() { stop(); }
+
+      // the merged recording, read it once the recorder is stopped
+      recorder_type merged{};
+      chunked<uint64_t> ticks{};
+
+      // a producer for one thread, created before start()
+      producer& add_producer()
+      {
+         if (collector.joinable()) {
+            throw std::runtime_error("concurrent_recorder: producers must be added before start()");
+         }
+         return producers.emplace_back(*this, queue_capacity);
+      }
+
+      // starts the background collector
+      void start()
+      {
+         if (collector.joinable()) {
+            return;
+         }
+         stopping.store(false, std::memory_order_relaxed);
+         collector = std::thread([this] {
+            while (!stopping.load(std::memory_order_acquire)) {
+               if (collect(false) == 0) {
+                  std::this_thread::sleep_for(std::chrono::microseconds(50));
+               }
+            }
+            collect(true);
+         });
+      }
+
+      // merges everything published so far and stops the collector, call after the producers are done
+      void stop()
+      {
+         if (!collector.joinable()) {
+            return;
+         }
+         stopping.store(true, std::memory_order_release);
+         collector.join();
+      }
+
+     private:
+      size_t queue_capacity{};
+      // a deque keeps producers in place as more are added
+      std::deque<producer> producers{};
+      std::atomic<bool> stopping{};
+      std::thread collector{};
+
+      // merges rows while every producer that has not finished has published, or while any has when draining, returns
+      // the rows merged
+      size_t collect(const bool draining)
+      {
+         size_t rows = 0;
+         while (true) {
+            uint64_t tick = std::numeric_limits<uint64_t>::max();
+            bool any = false;
+            for (auto& p : producers) {
+               if (p.available()) {
+                  any = true;
+                  tick = std::min(tick, p.front_tick());
+               }
+               else if (!draining && !p.drained()) {
+                  return rows;
+               }
+            }
+            if (!any) {
+               return rows;
+            }
+            for (auto& p : producers) {
+               if (p.available() && p.front_tick() == tick) {
+                  p.pop();
+               }
+            }
+            ticks.emplace_back(tick);
+            for (auto& p : producers) {
+               p.append();
+            }
+            ++rows;
+         }
+      }
+   };
+}
@@ -1,11 +1,19 @@
 #pragma once
 
+#include <algorithm>
 #include <string>
 #include <map>
 #include <vector>
 #include <variant>
 #include <deque>
+#include <functional>
+#include <stdexcept>
+#include <tuple>
 
+#include "glaze/file/mapped_column.hpp"
+#include "glaze/util/chunked.hpp"
+#include "glaze/util/gorilla.hpp"
+#include "glaze/util/ring.hpp"
 #include "glaze/util/type_traits.hpp"
 #include "glaze/util/string_view.hpp"
 #include "glaze/util/variant.hpp"
@@ -14,6 +22,35 @@ namespace glz
 {
    namespace detail
    {
+      // channels are chunked, unless the recorder type is glz::compressed<T>, which stores its samples compressed,
+      // glz::ring<T>, which keeps only the newest samples, or glz::mapped_column<T>, which writes them to a file
+      // values that do not fit a chunk block are kept in a std::deque
+      template <class T>
+      struct recorder_storage
+      {
+         using type = std::conditional_t<sizeof(T) <= block_pool::block_size &&
+                                            alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__,
+                                         chunked<T>, std::deque<T>>;
+      };
+      
+      template <class T>
+      struct recorder_storage<compressed<T>>
+      {
+         using type = compressed<T>;
+      };
+
+      template <class T>
+      struct recorder_storage<ring<T>>
+      {
+         using type = ring<T>;
+      };
+
+      template <class T>
+      struct recorder_storage<mapped_column<T>>
+      {
+         using type = mapped_column<T>;
+      };
+      
       template <class Data>
       struct recorder_assigner
       {
@@ -25,44 +62,185 @@ namespace glz
          
          Data& data;
          sv name{};
+         size_t ring_capacity{};
+         sv column_directory{};
+         // bumped when a channel is registered, so that the recorder regroups its channels
+         size_t* generation{};
          
          template <class T>
          void operator=(T& ref) {
             using container_type = std::decay_t<decltype(data[0].second.first)>;
-            data.emplace_back(std::pair{ name, std::make_pair(container_type{std::deque<T>{}}, &ref) });
+            if (generation) {
+               ++*generation;
+            }
+            // a plain channel for T is preferred over a ring, a ring over a mapped column, and a mapped column over a
+            // compressed channel
+            using plain_type = typename recorder_storage<T>::type;
+            if constexpr (variant_holds_v<container_type, plain_type>) {
+               data.emplace_back(std::pair{ name, std::make_pair(container_type{plain_type{}}, &ref) });
+            }
+            else if constexpr (variant_holds_v<container_type, ring<T>>) {
+               if (ring_capacity == 0) {
+                  throw std::runtime_error("recorder: set ring_capacity before registering ring channels");
+               }
+               data.emplace_back(std::pair{ name, std::make_pair(container_type{ring<T>{ring_capacity}}, &ref) });
+            }
+            else if constexpr (variant_holds_v<container_type, mapped_column<T>>) {
+               if (column_directory.empty()) {
+                  throw std::runtime_error("recorder: set column_directory before registering mapped columns");
+               }
+               auto path = std::string{column_directory} + "/" + std::string{name} + ".col";
+               data.emplace_back(
+                  std::pair{ name, std::make_pair(container_type{mapped_column<T>{path}}, &ref) });
+            }
+            else {
+               data.emplace_back(std::pair{ name, std::make_pair(container_type{compressed<T>{}}, &ref) });
+            }
+         }
+      };
+
+      // a channel bound to the variable it records
+      template <class Container>
+      struct recorder_source
+      {
+         Container* samples{};
+         const typename Container::value_type* source{};
+      };
+
+      // the channels grouped by storage type, so that an update appends to each group in a loop without dispatch
+      // copies start unresolved, as their pointers refer to another recorder
+      template <class... Containers>
+      struct recorder_channels
+      {
+         static constexpr size_t unresolved = ~size_t{};
+
+         std::tuple<std::vector<recorder_source<Containers>>...> groups{};
+         // the recorder's generation the groups were built for
+         size_t resolved = unresolved;
+
+         recorder_channels() = default;
+         recorder_channels(const recorder_channels&) {}
+         recorder_channels(recorder_channels&&) noexcept {}
+         recorder_channels& operator=(const recorder_channels&)
+         {
+            reset();
+            return *this;
+         }
+         recorder_channels& operator=(recorder_channels&&) noexcept
+         {
+            reset();
+            return *this;
+         }
+
+         void reset() noexcept
+         {
+            std::apply([](auto&... group) { (group.clear(), ...); }, groups);
+            resolved = unresolved;
          }
       };
    }
 
    /// <summary>
    /// recorder for saving state over the course of a run
-   /// deques are used to avoid reallocation for large amounts of data as the recording length is typically unknown
+   /// samples are stored in chunks from a shared block pool, which never reallocate as the recording length is
+   /// typically unknown, and channels are grouped by type when they are registered so that updates do not dispatch
+   /// glz::compressed<T> as a type records T values Gorilla compressed, e.g. glz::recorder<glz::compressed<double>, float>
+   /// glz::ring<T> as a type keeps the newest ring_capacity T values in storage allocated when the channel is registered,
+   /// e.g. glz::recorder<glz::ring<double>> as a flight recorder, writing the recorder writes the current window
+   /// glz::mapped_column<T> as a type writes T values to the memory mapped file column_directory/<name>.col, for
+   /// recordings larger than memory
    /// </summary>
    template <class... Ts>
    struct recorder
    {
-      using container_type = std::variant<std::deque<Ts>...>;
+      using container_type = std::variant<typename detail::recorder_storage<Ts>::type...>;
+      // sequential access to any channel, compressed channels can only be decoded in order
+      using iterator_type = std::variant<typename detail::recorder_storage<Ts>::type::const_iterator...>;
 
+      // a deque keeps the channels in place as more are registered
       std::deque<std::pair<std::string, std::pair<container_type, void*>>>
          data;
       
+      // samples are kept in the channels, a streaming sink can turn this off to keep memory flat over long runs
+      bool retain = true;
+      
+      // called at the end of every update, e.g. by glz::csv_sink
+      std::function<void()> on_update{};
+      
+      // samples kept by each glz::ring<T> channel, applies to channels registered afterwards
+      size_t ring_capacity{};
+      
+      // existing directory for the files of glz::mapped_column<T> channels, applies to channels registered afterwards
+      std::string column_directory{};
+      
+      // bumped on every change to the channels in data, code that adds or removes entries of data directly must bump it
+      size_t generation{};
+      
       auto operator[](const sv name) {
-         return detail::recorder_assigner<decltype(data)>{ data, name };
+         return detail::recorder_assigner<decltype(data)>{ data, name, ring_capacity, column_directory, &generation };
+      }
+      
+      // removes the channel registered as name, returns false if there is none
+      bool erase(const sv name)
+      {
+         auto it = std::find_if(data.begin(), data.end(), [&](const auto& entry) { return entry.first == name; });
+         if (it == data.end()) {
+            return false;
+         }
+         data.erase(it);
+         ++generation;
+         return true;
       }
 
       void update()
       {
+         if (retain) {
+            store();
+         }
+         if (on_update) {
+            on_update();
+         }
+      }
+      
+     private:
+      detail::recorder_channels<typename detail::recorder_storage<Ts>::type...> channels{};
+
+      void store()
+      {
+         if (channels.resolved != generation) [[unlikely]] {
+            resolve();
+         }
+         std::apply(
+            [](auto&... group) {
+               (
+                  [&] {
+                     for (auto& [samples, source] : group) {
+                        samples->emplace_back(*source);
+                     }
+                  }(),
+                  ...);
+            },
+            channels.groups);
+      }
+
+      // sorts the channels into their type groups, done again whenever the generation changes
+      void resolve()
+      {
+         channels.reset();
          for (auto& [name, value] : data) {
-            auto* ptr = value.second;
+            if (!value.second) {
+               continue;
+            }
             std::visit(
-               [&](auto&& container) {
-                  using ContainerType = std::decay_t<decltype(container)>;
-                  using T = typename ContainerType::value_type;
-
-                  container.emplace_back(*static_cast<T*>(ptr));
+               [&](auto& container) {
+                  using Container = std::decay_t<decltype(container)>;
+                  using T = typename Container::value_type;
+                  std::get<std::vector<detail::recorder_source<Container>>>(channels.groups)
+                     .emplace_back(&container, static_cast<const T*>(value.second));
                },
                value.first);
          }
+         channels.resolved = generation;
       }
    };
 }
@@ -0,0 +1,95 @@
+// Glaze Library
+// For the license information refer to glaze.hpp
+
+#pragma once
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <variant>
+
+#include "glaze/binary/read.hpp"
+#include "glaze/binary/write.hpp"
+#include "glaze/record/recorder.hpp"
+
+// binary format of glz::recorder, kept out of the core binary headers so that they do not pull in the recorder's
+// storage and file mapping headers
+namespace glz::detail
+{
+   // [channel count], then per channel [name] [uint64 layout hash of the storage] [samples]
+   template <class... Ts>
+   struct to_binary<recorder<Ts...>> final
+   {
+      template <auto Opts, class... Args>
+      static void op(auto&& rec, is_context auto&& ctx, Args&&... args) noexcept(Opts.no_except)
+      {
+         dump_int<Opts>(rec.data.size(), args...);
+         for (auto& [name, channel] : rec.data) {
+            write<binary>::op<Opts>(name, ctx, args...);
+            std::visit(
+               [&](auto&& samples) {
+                  dump_type(wire_order<Opts>(layout_hash_v<std::decay_t<decltype(samples)>>), args...);
+                  write<binary>::op<Opts>(samples, ctx, args...);
+               },
+               channel.first);
+         }
+      }
+   };
+
+   // channels are matched by name and storage type, unknown channels are added without a recording source
+   template <class... Ts>
+   struct from_binary<recorder<Ts...>> final
+   {
+      template <auto Opts>
+      static void op(auto&& rec, is_context auto&& ctx, auto&& it, auto&& end)
+      {
+         using container_type = typename recorder<Ts...>::container_type;
+         static constexpr auto N = std::variant_size_v<container_type>;
+         const auto n = int_from_header<Opts>(it, end);
+         for (size_t i = 0; i < n; ++i) {
+            std::string name{};
+            read<binary>::op<Opts>(name, ctx, it, end);
+            uint64_t hash;
+            std::memcpy(&hash, &(*it), sizeof(hash));
+            hash = wire_order<Opts>(hash);
+            std::advance(it, sizeof(hash));
+
+            // storage types can share a wire format, e.g. glz::ring<T> and plain channels of T, a registered channel
+            // keeps its storage, a new one takes the first matching storage type
+            auto channel = std::find_if(rec.data.begin(), rec.data.end(),
+                                        [&](const auto& entry) { return entry.first == name; });
+            const bool exists = channel != rec.data.end();
+            bool matches = false;
+            size_t index = N;
+            for_each<N>([&](auto I) {
+               if (layout_hash_v<std::variant_alternative_t<I, container_type>> == hash) {
+                  matches = true;
+                  if (exists ? channel->second.first.index() == I : index == N) {
+                     index = I;
+                  }
+               }
+            });
+            if (!matches) [[unlikely]] {
+               throw std::runtime_error("recorder: channel " + name + " has an unsupported type");
+            }
+            if (index == N) [[unlikely]] {
+               throw std::runtime_error("recorder: channel " + name + " has a different type");
+            }
+
+            if (!exists) {
+               rec.data.emplace_back(name, std::make_pair(container_type{}, static_cast<void*>(nullptr)));
+               channel = std::prev(rec.data.end());
+            }
+
+            // the container is replaced, so the recorder regroups its channels
+            ++rec.generation;
+            auto& samples = channel->second.first;
+            for_each<N>([&](auto I) {
+               if (I == index) {
+                  read<binary>::op<Opts>(samples.template emplace<I>(), ctx, it, end);
+               }
+            });
+         }
+      }
+   };
+}
@@ -0,0 +1,123 @@
+// Glaze Library
+// For the license information refer to glaze.hpp
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace glz::detail
+{
+   /// <summary>
+   /// Chase-Lev work stealing deque of pointers, following Le, Pop, Cohen and Zappa Nardelli,
+   /// "Correct and Efficient Work-Stealing for Weak Memory Models" (2013)
+   /// the owning thread pushes and takes at the bottom without a lock, other threads steal from the top with one CAS
+   /// the orderings that must be sequentially consistent are made so on the operations themselves rather than with
+   /// standalone fences, which thread sanitizers understand
+   /// </summary>
+   template <class T>
+   struct steal_deque
+   {
+      explicit steal_deque(const size_t capacity = 1024)
+      {
+         auto first = std::make_unique<ring>(std::bit_ceil(std::max(capacity, size_t{2})));
+         buffer.store(first.get(), std::memory_order_relaxed);
+         rings.emplace_back(std::move(first));
+      }
+
+      steal_deque(const steal_deque&) = delete;
+      steal_deque& operator=(const steal_deque&) = delete;
+
+      // owner only
+      void push(T* item)
+      {
+         const auto b = bottom.load(std::memory_order_relaxed);
+         const auto t = top.load(std::memory_order_acquire);
+         auto* a = buffer.load(std::memory_order_relaxed);
+         if (b - t > static_cast<int64_t>(a->mask)) [[unlikely]] {
+            a = grow(a, t, b);
+         }
+         a->put(b, item);
+         // sequentially consistent so that a thread about to sleep either sees the item or is seen as sleeping
+         bottom.store(b + 1, std::memory_order_seq_cst);
+      }
+
+      // owner only, the newest item or nullptr
+      T* take()
+      {
+         const auto b = bottom.load(std::memory_order_relaxed) - 1;
+         auto* a = buffer.load(std::memory_order_relaxed);
+         bottom.store(b, std::memory_order_seq_cst);
+         auto t = top.load(std::memory_order_seq_cst);
+         if (t > b) {
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return nullptr;
+         }
+         T* item = a->get(b);
+         if (t == b) {
+            // the last item, which a thief may be taking at the same time
+            if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+               item = nullptr;
+            }
+            bottom.store(b + 1, std::memory_order_relaxed);
+         }
+         return item;
+      }
+
+      // any thread, the oldest item, or nullptr when empty or when another thread won the race for it
+      T* steal()
+      {
+         auto t = top.load(std::memory_order_seq_cst);
+         const auto b = bottom.load(std::memory_order_seq_cst);
+         if (t >= b) {
+            return nullptr;
+         }
+         auto* a = buffer.load(std::memory_order_acquire);
+         T* item = a->get(t);
+         if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            return nullptr;
+         }
+         return item;
+      }
+
+      bool empty() const noexcept
+      {
+         return bottom.load(std::memory_order_seq_cst) <= top.load(std::memory_order_seq_cst);
+      }
+
+     private:
+      struct ring
+      {
+         explicit ring(const size_t capacity) : mask(capacity - 1), slots(new std::atomic<T*>[capacity]) {}
+
+         size_t mask{};
+         std::unique_ptr<std::atomic<T*>[]> slots{};
+
+         T* get(const int64_t i) const noexcept { return slots[i & mask].load(std::memory_order_relaxed); }
+         void put(const int64_t i, T* item) noexcept { slots[i & mask].store(item, std::memory_order_relaxed); }
+      };
+
+      alignas(64) std::atomic<int64_t> top{};
+      alignas(64) std::atomic<int64_t> bottom{};
+      std::atomic<ring*> buffer{};
+      // outgrown rings are kept until the deque is destroyed, as a thief may still be reading one
+      std::vector<std::unique_ptr<ring>> rings{};
+
+      ring* grow(ring* a, const int64_t t, const int64_t b)
+      {
+         auto larger = std::make_unique<ring>(2 * (a->mask + 1));
+         for (auto i = t; i < b; ++i) {
+            larger->put(i, a->get(i));
+         }
+         a = larger.get();
+         buffer.store(a, std::memory_order_release);
+         rings.emplace_back(std::move(larger));
+         return a;
+      }
+   };
+}
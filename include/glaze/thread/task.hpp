@@ -0,0 +1,261 @@
+// Glaze Library
+// For the license information refer to glaze.hpp
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace glz
+{
+   namespace detail
+   {
+      // a task in the pool's deques, invoke runs it and releases whatever the task owns
+      struct pool_task
+      {
+         void (*invoke)(pool_task*, const size_t thread_number){};
+      };
+
+      /// <summary>
+      /// a task of pool::emplace_back together with its completion state, shared by the pool and the task_handle
+      /// the callable and then the result are kept in the inline storage, larger ones are boxed on the heap
+      /// slots are recycled through per thread caches, so submitting a small task does not allocate
+      /// </summary>
+      struct alignas(64) task_slot : pool_task
+      {
+         static constexpr size_t slot_size = 128;
+
+         std::atomic<uint32_t> done{};
+         std::atomic<uint32_t> refs{};
+         // destroys the result, set once the task has produced one
+         void (*destroy)(task_slot*){};
+         std::exception_ptr error{};
+         alignas(std::max_align_t) std::byte storage[slot_size - 32];
+      };
+      static_assert(sizeof(task_slot) == task_slot::slot_size);
+
+      template <class T>
+      inline constexpr bool fits_task_slot = sizeof(T) <= sizeof(task_slot::storage) &&
+                                             alignof(T) <= alignof(std::max_align_t) &&
+                                             std::is_nothrow_move_constructible_v<T>;
+
+      // T inline in the slot when it fits, otherwise a pointer to T
+      template <class T>
+      using slot_stored_t = std::conditional_t<fits_task_slot<T>, T, std::unique_ptr<T>>;
+
+      template <class T>
+      T& slot_value(task_slot& slot) noexcept
+      {
+         auto& stored = *std::launder(reinterpret_cast<slot_stored_t<T>*>(slot.storage));
+         if constexpr (fits_task_slot<T>) {
+            return stored;
+         }
+         else {
+            return *stored;
+         }
+      }
+
+      template <class T, class... Args>
+      void construct_slot_value(task_slot& slot, Args&&... args)
+      {
+         if constexpr (fits_task_slot<T>) {
+            new (slot.storage) T(std::forward<Args>(args)...);
+         }
+         else {
+            new (slot.storage) std::unique_ptr<T>(std::make_unique<T>(std::forward<Args>(args)...));
+         }
+      }
+
+      template <class T>
+      void destroy_slot_value(task_slot& slot) noexcept
+      {
+         std::destroy_at(std::launder(reinterpret_cast<slot_stored_t<T>*>(slot.storage)));
+      }
+
+      // slots handed between threads in batches, never returned to the system
+      struct task_slot_stash
+      {
+         static constexpr size_t batch = 64;
+
+         std::mutex mtx;
+         std::vector<task_slot*> slots;
+      };
+
+      inline task_slot_stash& shared_task_slots()
+      {
+         static auto& stash = *new task_slot_stash{};
+         return stash;
+      }
+
+      struct task_slot_cache
+      {
+         std::vector<task_slot*> slots;
+
+         ~task_slot_cache()
+         {
+            auto& stash = shared_task_slots();
+            std::lock_guard lock{stash.mtx};
+            stash.slots.insert(stash.slots.end(), slots.begin(), slots.end());
+         }
+      };
+
+      inline thread_local task_slot_cache local_task_slots{};
+
+      inline task_slot* allocate_task_slot()
+      {
+         auto& cache = local_task_slots.slots;
+         if (cache.empty()) {
+            auto& stash = shared_task_slots();
+            std::lock_guard lock{stash.mtx};
+            const auto n = std::min(stash.slots.size(), task_slot_stash::batch);
+            cache.insert(cache.end(), stash.slots.end() - n, stash.slots.end());
+            stash.slots.resize(stash.slots.size() - n);
+         }
+         task_slot* slot{};
+         if (cache.empty()) {
+            slot = new task_slot{};
+         }
+         else {
+            slot = cache.back();
+            cache.pop_back();
+         }
+         slot->done.store(0, std::memory_order_relaxed);
+         slot->refs.store(2, std::memory_order_relaxed);
+         slot->destroy = nullptr;
+         slot->error = nullptr;
+         return slot;
+      }
+
+      // drops one of the two references to a slot, the last one recycles it
+      inline void release_task_slot(task_slot* slot) noexcept
+      {
+         if (slot->refs.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+            return;
+         }
+         if (slot->destroy) {
+            slot->destroy(slot);
+         }
+         slot->error = nullptr;
+         auto& cache = local_task_slots.slots;
+         cache.emplace_back(slot);
+         if (cache.size() >= 2 * task_slot_stash::batch) {
+            auto& stash = shared_task_slots();
+            std::lock_guard lock{stash.mtx};
+            stash.slots.insert(stash.slots.end(), cache.end() - task_slot_stash::batch, cache.end());
+            cache.resize(cache.size() - task_slot_stash::batch);
+         }
+      }
+
+      template <class F, class R>
+      void run_task_slot(pool_task* task, const size_t thread_number)
+      {
+         auto& slot = *static_cast<task_slot*>(task);
+         bool callable = true;
+         try {
+            auto& f = slot_value<F>(slot);
+            if constexpr (std::is_void_v<R>) {
+               f(thread_number);
+               callable = false;
+               destroy_slot_value<F>(slot);
+            }
+            else {
+               R result = f(thread_number);
+               callable = false;
+               destroy_slot_value<F>(slot);
+               construct_slot_value<R>(slot, std::move(result));
+               slot.destroy = [](task_slot* s) { destroy_slot_value<R>(*s); };
+            }
+         }
+         catch (...) {
+            if (callable) {
+               destroy_slot_value<F>(slot);
+            }
+            slot.error = std::current_exception();
+         }
+         slot.done.store(1, std::memory_order_release);
+         slot.done.notify_all();
+         release_task_slot(&slot);
+      }
+   }
+
+   /// <summary>
+   /// handle to the result of a task submitted with pool::emplace_back, in place of a std::future
+   /// the result lives in the task's slot, so there is no shared state to allocate, waiting is an atomic wait on the
+   /// completion flag, which is a futex on Linux, and only enters the kernel when the task is not done yet
+   /// like a std::future, get() can be called once, dropping a handle does not wait for the task
+   /// a task waiting on another task's handle blocks its worker, use parallel_for for work that nests
+   /// </summary>
+   template <class R>
+   struct task_handle
+   {
+      task_handle() = default;
+      explicit task_handle(detail::task_slot* slot) noexcept : slot(slot) {}
+
+      task_handle(const task_handle&) = delete;
+      task_handle& operator=(const task_handle&) = delete;
+
+      task_handle(task_handle&& other) noexcept : slot(std::exchange(other.slot, nullptr)) {}
+      task_handle& operator=(task_handle&& other) noexcept
+      {
+         if (this != &other) {
+            reset();
+            slot = std::exchange(other.slot, nullptr);
+         }
+         return *this;
+      }
+
+      ~task_handle() { reset(); }
+
+      bool valid() const noexcept { return slot != nullptr; }
+
+      bool ready() const noexcept { return slot && slot->done.load(std::memory_order_acquire) != 0; }
+
+      void wait() const
+      {
+         if (!slot) {
+            throw std::runtime_error("task_handle: no task");
+         }
+         while (slot->done.load(std::memory_order_acquire) == 0) {
+            slot->done.wait(0, std::memory_order_acquire);
+         }
+      }
+
+      // waits for the task and returns its result, or rethrows its exception
+      R get()
+      {
+         wait();
+         auto* s = std::exchange(slot, nullptr);
+         struct release
+         {
+            detail::task_slot* s;
+            ~release() { detail::release_task_slot(s); }
+         } guard{s};
+         if (s->error) {
+            std::rethrow_exception(s->error);
+         }
+         if constexpr (!std::is_void_v<R>) {
+            return std::move(detail::slot_value<R>(*s));
+         }
+      }
+
+     private:
+      detail::task_slot* slot{};
+
+      void reset() noexcept
+      {
+         if (slot) {
+            detail::release_task_slot(std::exchange(slot, nullptr));
+         }
+      }
+   };
+}
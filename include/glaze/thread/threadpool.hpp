@@ -3,28 +3,137 @@
 
 #pragma once
 
+#include <algorithm>
 #include <atomic>
-#include <condition_variable>
+#include <cstdint>
 #include <deque>
+#include <exception>
 #include <functional>
-#include <future>
+#include <latch>
+#include <memory>
 #include <mutex>
 #include <thread>
 #include <vector>
 
+#include "glaze/thread/steal_deque.hpp"
+#include "glaze/thread/task.hpp"
 #include "glaze/util/macros.hpp"
 
 namespace glz
 {
-   // A simple threadpool
+   struct pool;
+
+   namespace detail
+   {
+      // the tasks of emplace_bulk share one allocation, freed by the last task to finish
+      template <class F>
+      struct bulk_tasks
+      {
+         struct item final : pool_task
+         {
+            bulk_tasks* owner{};
+            size_t index{};
+
+            static void call(pool_task* task, const size_t thread_number)
+            {
+               auto& self = *static_cast<item*>(task);
+               auto* owner = self.owner;
+               owner->f(self.index, thread_number);
+               if (owner->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                  delete owner;
+               }
+            }
+         };
+
+         F f;
+         std::atomic<size_t> remaining{};
+         std::unique_ptr<item[]> items{};
+
+         bulk_tasks(F&& f, const size_t n) : f(std::move(f)), remaining(n), items(new item[n])
+         {
+            for (size_t i = 0; i < n; ++i) {
+               items[i].invoke = &item::call;
+               items[i].owner = this;
+               items[i].index = i;
+            }
+         }
+      };
+
+      // the ranges of one parallel_for, which lives on the caller's stack until the latch opens
+      template <class F>
+      struct range_tasks
+      {
+         struct item final : pool_task
+         {
+            range_tasks* owner{};
+            size_t first{};
+            size_t last{};
+
+            static void call(pool_task* task, const size_t)
+            {
+               auto& self = *static_cast<item*>(task);
+               self.owner->run(self.first, self.last);
+            }
+         };
+
+         F& f;
+         std::latch done;
+         std::atomic<bool> failed{};
+         std::exception_ptr error{};
+
+         range_tasks(F& f, const size_t n) : f(f), done(static_cast<std::ptrdiff_t>(n)) {}
+
+         void run(const size_t first, const size_t last) noexcept
+         {
+            try {
+               for (size_t i = first; i < last; ++i) {
+                  f(i);
+               }
+            }
+            catch (...) {
+               if (!failed.exchange(true, std::memory_order_relaxed)) {
+                  error = std::current_exception();
+               }
+            }
+            done.count_down();
+         }
+      };
+
+      // the pool and worker index of the calling thread, when it is a pool worker
+      struct pool_worker_id
+      {
+         const pool* owner{};
+         size_t index{};
+      };
+
+      inline thread_local pool_worker_id current_pool_worker{};
+   }
+
+   /// <summary>
+   /// work stealing thread pool
+   /// every worker owns a Chase-Lev deque: tasks submitted from a worker go to its own deque without a lock, and an
+   /// idle worker steals the oldest tasks of the others, tasks submitted from other threads go through a shared queue
+   /// that workers drain in batches into their deques
+   /// idle workers sleep on an atomic wait, so a submission only makes a system call when a worker is asleep
+   /// </summary>
    struct pool
    {
       pool() : pool(concurrency()) {}
 
       pool(const size_t n) { n_threads(n); }
 
+      // resizes the pool, waiting for the queued work first
       void n_threads(const size_t n)
       {
+         if (n == threads.size()) {
+            return;
+         }
+         stop();
+         workers.clear();
+         for (size_t i = 0; i < n; ++i) {
+            workers.emplace_back(std::make_unique<worker_state>());
+         }
+         closed.store(false, std::memory_order_relaxed);
 #ifdef _WIN32
          // NOT REQUIRED IN WINDOWS 11
          // TODO smarter distrubution of threads among groups.
@@ -64,96 +173,315 @@ namespace glz
 #endif
       }
 
+      /// <summary>
+      /// submits func(thread_number) and returns a glz::task_handle to its result
+      /// the callable and the result share one recycled slot with the completion flag, so small tasks do not allocate
+      /// </summary>
       template <class F>
-      std::future<std::invoke_result_t<std::decay_t<F>, size_t>> emplace_back(F&& func)
+      task_handle<std::invoke_result_t<std::decay_t<F>, size_t>> emplace_back(F&& func)
       {
-         using result_type = decltype(func(size_t{}));
+         using callable_type = std::decay_t<F>;
+         using result_type = std::invoke_result_t<callable_type, size_t>;
 
-         std::lock_guard lock(mtx);
+         auto* slot = detail::allocate_task_slot();
+         try {
+            detail::construct_slot_value<callable_type>(*slot, std::forward<F>(func));
+         }
+         catch (...) {
+            slot->refs.store(1, std::memory_order_relaxed);
+            detail::release_task_slot(slot);
+            throw;
+         }
+         slot->invoke = &detail::run_task_slot<callable_type, result_type>;
+         task_handle<result_type> handle{slot};
+         detail::pool_task* item = slot;
+         submit(&item, 1);
+         return handle;
+      }
 
-         auto promise = std::make_shared<std::promise<result_type>>();
+      /// <summary>
+      /// submits n tasks that call func(index, thread_number), with one allocation and one lock for all of them
+      /// there are no futures, use wait() for completion, an exception thrown by func terminates
+      /// </summary>
+      template <class F>
+      void emplace_bulk(const size_t n, F&& func)
+      {
+         if (n == 0) {
+            return;
+         }
+         auto* tasks = new detail::bulk_tasks<std::decay_t<F>>(std::decay_t<F>(std::forward<F>(func)), n);
+         submit(tasks->items.get(), n);
+      }
 
-         queue.emplace(last_index++, [=, f = std::forward<F>(func)](const size_t thread_number) {
-            try {
-               if constexpr (std::is_void<result_type>::value) {
-                  f(thread_number);
+      /// <summary>
+      /// calls func(i) for every i in [begin, end) on the pool and returns when all calls have finished
+      /// the indices are split into ranges of grain indices, grain = 0 picks about four ranges per worker so that
+      /// stealing can even out uneven ranges, the calling thread runs the first range itself
+      /// completion is counted by a single latch, the first exception thrown by func is rethrown here
+      /// called from a task of this pool, the calling worker runs other tasks while it waits
+      /// </summary>
+      template <class F>
+      void parallel_for(const size_t begin, const size_t end, size_t grain, F&& func)
+      {
+         if (begin >= end) {
+            return;
+         }
+         const size_t n = end - begin;
+         if (grain == 0) {
+            const auto ranges = 4 * std::max(size(), size_t{1});
+            grain = (n + ranges - 1) / ranges;
+         }
+         const size_t n_ranges = (n + grain - 1) / grain;
+         if (n_ranges == 1 || threads.empty()) {
+            for (size_t i = begin; i < end; ++i) {
+               func(i);
+            }
+            return;
+         }
+
+         using group_type = detail::range_tasks<std::remove_reference_t<F>>;
+         group_type group{func, n_ranges};
+         std::vector<typename group_type::item> ranges(n_ranges - 1);
+         for (size_t r = 1; r < n_ranges; ++r) {
+            auto& range = ranges[r - 1];
+            range.invoke = &group_type::item::call;
+            range.owner = &group;
+            range.first = begin + r * grain;
+            range.last = std::min(range.first + grain, end);
+         }
+         submit(ranges.data(), ranges.size());
+
+         group.run(begin, begin + grain);
+
+         const auto& self = detail::current_pool_worker;
+         if (self.owner == this) {
+            while (!group.done.try_wait()) {
+               if (auto* task = next_task(self.index)) {
+                  run(task, self.index);
                }
                else {
-                  promise->set_value(f(thread_number));
+                  std::this_thread::yield();
                }
             }
-            catch (...) {
-               promise->set_exception(std::current_exception());
-            }
-         });
-
-         work_cv.notify_one();
+         }
+         else {
+            group.done.wait();
+         }
 
-         return promise->get_future();
+         if (group.error) {
+            std::rethrow_exception(group.error);
+         }
       }
 
-      bool computing() const { return (working != 0); }
+      bool computing() const { return pending.load(std::memory_order_acquire) != 0; }
 
+      // waits until every submitted task has finished, must not be called from a task
       void wait()
       {
-         std::unique_lock lock(mtx);
-         if (queue.empty() && (working == 0)) return;
-         done_cv.wait(lock, [&]() { return queue.empty() && (working == 0); });
+         auto n = pending.load(std::memory_order_acquire);
+         while (n != 0) {
+            pending.wait(n, std::memory_order_acquire);
+            n = pending.load(std::memory_order_acquire);
+         }
       }
 
       size_t size() const { return threads.size(); }
 
       ~pool()
       {
-         // Close the queue and finish all the remaining work
-         std::unique_lock lock(mtx);
-         closed = true;
-         work_cv.notify_all();
-         lock.unlock();
-
-         for (auto &t : threads)
-            if (t.joinable()) t.join();
+         // finish all the remaining work
+         stop();
       }
 
      private:
+      struct worker_state
+      {
+         detail::steal_deque<detail::pool_task> tasks{};
+         uint64_t seed{}; // for picking steal victims
+      };
+
+      // tasks taken from the shared queue at once, at most
+      static constexpr size_t max_batch = 64;
+
       std::vector<std::thread> threads;
-      std::unordered_map<size_t, std::function<void(const size_t)>> queue;
-      std::atomic<size_t> front_index{};
-      std::atomic<size_t> last_index{};
-      std::atomic<unsigned int> working = 0;
-      bool closed = false;
+      std::vector<std::unique_ptr<worker_state>> workers;
+
+      // submissions from threads outside the pool
       std::mutex mtx;
-      std::condition_variable work_cv;
-      std::condition_variable done_cv;
+      std::deque<detail::pool_task*> queue;
+      std::atomic<size_t> queued{};
 
-      void worker(const size_t thread_number)
+      // tasks submitted and not yet finished
+      std::atomic<size_t> pending{};
+      // bumped to wake sleeping workers
+      std::atomic<uint32_t> epoch{};
+      std::atomic<size_t> sleepers{};
+      std::atomic<bool> closed{};
+
+      // queues n tasks stored contiguously, Task is detail::pool_task or derived from it
+      template <class Task>
+      void submit(Task* tasks, const size_t n)
       {
-         while (true) {
-            // Wait for work
-            std::unique_lock<std::mutex> lock(mtx);
-            work_cv.wait(lock, [this]() {
-               return closed || !(front_index == last_index);
-            });
-            if (queue.empty()) {
-               if (closed) {
-                  return;
+         pending.fetch_add(n, std::memory_order_relaxed);
+         const auto& self = detail::current_pool_worker;
+         if (self.owner == this) {
+            auto& deque = workers[self.index]->tasks;
+            for (size_t i = 0; i < n; ++i) {
+               deque.push(task_at(tasks, i));
+            }
+         }
+         else {
+            {
+               std::lock_guard lock(mtx);
+               for (size_t i = 0; i < n; ++i) {
+                  queue.emplace_back(task_at(tasks, i));
                }
+            }
+            queued.fetch_add(n, std::memory_order_seq_cst);
+         }
+         const auto idle = std::min(n, sleepers.load(std::memory_order_seq_cst));
+         for (size_t i = 0; i < idle; ++i) {
+            wake_one();
+         }
+      }
+
+      template <class Task>
+      static detail::pool_task* task_at(Task* tasks, const size_t i) noexcept
+      {
+         if constexpr (std::is_pointer_v<Task>) {
+            return tasks[i];
+         }
+         else {
+            return &tasks[i];
+         }
+      }
+
+      void wake_one()
+      {
+         epoch.fetch_add(1, std::memory_order_release);
+         epoch.notify_one();
+      }
+
+      void stop()
+      {
+         wait();
+         closed.store(true, std::memory_order_seq_cst);
+         epoch.fetch_add(1, std::memory_order_release);
+         epoch.notify_all();
+         for (auto& t : threads) {
+            if (t.joinable()) t.join();
+         }
+         threads.clear();
+      }
+
+      // moves a batch of the shared queue into this worker's deque and returns one task of it
+      detail::pool_task* take_queued(worker_state& self)
+      {
+         if (queued.load(std::memory_order_relaxed) == 0) {
+            return nullptr;
+         }
+         std::lock_guard lock(mtx);
+         if (queue.empty()) {
+            return nullptr;
+         }
+         // a share of the queue per worker, so one worker does not take everything
+         const auto n = std::min(std::max(queue.size() / workers.size(), size_t{1}), max_batch);
+         queued.fetch_sub(n, std::memory_order_relaxed);
+         auto* task = queue.front();
+         queue.pop_front();
+         for (size_t i = 1; i < n; ++i) {
+            self.tasks.push(queue.front());
+            queue.pop_front();
+         }
+         // sleeping workers are woken to steal the rest of the batch
+         const auto idle = std::min(n - 1, sleepers.load(std::memory_order_seq_cst));
+         for (size_t i = 0; i < idle; ++i) {
+            wake_one();
+         }
+         return task;
+      }
+
+      detail::pool_task* steal(const size_t thread_number, uint64_t& seed)
+      {
+         const auto n = workers.size();
+         if (n < 2) {
+            return nullptr;
+         }
+         // xorshift, to start from a different victim every time
+         seed ^= seed << 13;
+         seed ^= seed >> 7;
+         seed ^= seed << 17;
+         const auto start = static_cast<size_t>(seed % n);
+         for (size_t i = 0; i < n; ++i) {
+            const auto victim = (start + i) % n;
+            if (victim == thread_number) {
                continue;
             }
+            if (auto* task = workers[victim]->tasks.steal()) {
+               return task;
+            }
+         }
+         return nullptr;
+      }
+
+      bool has_work() const
+      {
+         if (queued.load(std::memory_order_seq_cst) != 0) {
+            return true;
+         }
+         for (auto& w : workers) {
+            if (!w->tasks.empty()) {
+               return true;
+            }
+         }
+         return false;
+      }
+
+      void run(detail::pool_task* task, const size_t thread_number)
+      {
+         task->invoke(task, thread_number);
+         if (pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            pending.notify_all();
+         }
+      }
 
-            // Grab work
-            ++working;
-            auto work = queue.find(front_index++);
-            lock.unlock();
+      // the next task for a worker: its own newest, a batch of the shared queue, or the oldest task of another worker
+      detail::pool_task* next_task(const size_t thread_number)
+      {
+         auto& self = *workers[thread_number];
+         auto* task = self.tasks.take();
+         if (!task) {
+            task = take_queued(self);
+         }
+         if (!task) {
+            task = steal(thread_number, self.seed);
+         }
+         return task;
+      }
 
-            work->second(thread_number);
-            
-            lock.lock();
-            queue.erase(work);
+      void worker(const size_t thread_number)
+      {
+         detail::current_pool_worker = {this, thread_number};
+         workers[thread_number]->seed = 0x9e3779b97f4a7c15ull * (thread_number + 1);
+         while (true) {
+            if (auto* task = next_task(thread_number)) {
+               run(task, thread_number);
+               continue;
+            }
 
-            // Notify that work is finished
-            --working;
-            done_cv.notify_all();
+            // sleep until woken, the work check after announcing the sleep pairs with the sleepers check of submit
+            const auto e = epoch.load(std::memory_order_acquire);
+            sleepers.fetch_add(1, std::memory_order_seq_cst);
+            if (has_work()) {
+               sleepers.fetch_sub(1, std::memory_order_relaxed);
+               continue;
+            }
+            if (closed.load(std::memory_order_seq_cst)) {
+               sleepers.fetch_sub(1, std::memory_order_relaxed);
+               return;
+            }
+            epoch.wait(e, std::memory_order_acquire);
+            sleepers.fetch_sub(1, std::memory_order_relaxed);
          }
       }
    };
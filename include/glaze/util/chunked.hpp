@@ -0,0 +1,307 @@
+// Glaze Library
+// For the license information refer to glaze.hpp
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace glz
+{
+   /// <summary>
+   /// free list of fixed size blocks shared by chunked containers
+   /// blocks are taken from the system once and reused after they are released, so long recordings do not hit the
+   /// allocator for every chunk and cleared channels hand their memory to the next ones
+   /// released blocks are handed out again in address order, which keeps the blocks being filled side by side in few
+   /// pages when many channels grow in lockstep
+   /// </summary>
+   struct block_pool
+   {
+      // small blocks keep the blocks being written by hundreds of channels within the TLB
+      static constexpr size_t block_size = 512;
+
+      block_pool() = default;
+      block_pool(const block_pool&) = delete;
+      block_pool& operator=(const block_pool&) = delete;
+
+      ~block_pool()
+      {
+         for (auto* block : ready) {
+            ::operator delete(block);
+         }
+         for (auto* block : released) {
+            ::operator delete(block);
+         }
+      }
+
+      void* allocate()
+      {
+         {
+            std::lock_guard lock{mtx};
+            if (ready.empty() && released.size()) {
+               // sorted once per generation of released blocks, the lowest address is at the back
+               std::sort(released.begin(), released.end(), std::greater<>{});
+               std::swap(ready, released);
+            }
+            if (ready.size()) {
+               auto* block = ready.back();
+               ready.pop_back();
+               return block;
+            }
+         }
+         return ::operator new(block_size);
+      }
+
+      void release(void* block)
+      {
+         std::lock_guard lock{mtx};
+         released.emplace_back(block);
+      }
+
+      // releases a range of blocks under one lock
+      template <class It>
+      void release(It first, It last)
+      {
+         std::lock_guard lock{mtx};
+         released.insert(released.end(), first, last);
+      }
+
+      // blocks waiting to be reused
+      size_t available() const
+      {
+         std::lock_guard lock{mtx};
+         return ready.size() + released.size();
+      }
+
+     private:
+      mutable std::mutex mtx;
+      std::vector<void*> ready; // sorted in descending address order
+      std::vector<void*> released;
+   };
+
+   // the process wide pool, never destroyed so that containers with static storage may release into it at exit
+   inline block_pool& shared_block_pool()
+   {
+      static auto& pool = *new block_pool{};
+      return pool;
+   }
+
+   /// <summary>
+   /// sequence stored in fixed size blocks from the shared block_pool
+   /// appending never moves existing elements and costs one store, plus a block from the pool every chunk_size values
+   /// this is the storage of recorder channels
+   /// </summary>
+   template <class T>
+   struct chunked
+   {
+      static_assert(sizeof(T) <= block_pool::block_size, "chunked: element larger than a block");
+      static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "chunked: over aligned element");
+
+      using value_type = T;
+      using size_type = size_t;
+      using difference_type = std::ptrdiff_t;
+      using reference = T&;
+      using const_reference = const T&;
+
+      static constexpr size_t chunk_size = block_pool::block_size / sizeof(T);
+
+      template <bool Const>
+      struct iterator_impl
+      {
+         using iterator_category = std::random_access_iterator_tag;
+         using value_type = T;
+         using difference_type = std::ptrdiff_t;
+         using reference = std::conditional_t<Const, const T&, T&>;
+         using pointer = std::conditional_t<Const, const T*, T*>;
+
+         T* const* blocks{};
+         size_t index{};
+
+         iterator_impl() = default;
+         iterator_impl(T* const* blocks, const size_t index) noexcept : blocks(blocks), index(index) {}
+
+         template <bool C = Const>
+         requires C
+         iterator_impl(const iterator_impl<false>& other) noexcept : blocks(other.blocks), index(other.index)
+         {}
+
+         reference operator*() const noexcept { return blocks[index / chunk_size][index % chunk_size]; }
+         pointer operator->() const noexcept { return &**this; }
+         reference operator[](const difference_type n) const noexcept { return *(*this + n); }
+
+         iterator_impl& operator++() noexcept
+         {
+            ++index;
+            return *this;
+         }
+         iterator_impl operator++(int) noexcept
+         {
+            auto ret = *this;
+            ++index;
+            return ret;
+         }
+         iterator_impl& operator--() noexcept
+         {
+            --index;
+            return *this;
+         }
+         iterator_impl operator--(int) noexcept
+         {
+            auto ret = *this;
+            --index;
+            return ret;
+         }
+         iterator_impl& operator+=(const difference_type n) noexcept
+         {
+            index += n;
+            return *this;
+         }
+         iterator_impl& operator-=(const difference_type n) noexcept
+         {
+            index -= n;
+            return *this;
+         }
+         friend iterator_impl operator+(iterator_impl it, const difference_type n) noexcept { return it += n; }
+         friend iterator_impl operator+(const difference_type n, iterator_impl it) noexcept { return it += n; }
+         friend iterator_impl operator-(iterator_impl it, const difference_type n) noexcept { return it -= n; }
+         friend difference_type operator-(const iterator_impl& a, const iterator_impl& b) noexcept
+         {
+            return static_cast<difference_type>(a.index) - static_cast<difference_type>(b.index);
+         }
+         bool operator==(const iterator_impl& other) const noexcept { return index == other.index; }
+         auto operator<=>(const iterator_impl& other) const noexcept { return index <=> other.index; }
+      };
+
+      using iterator = iterator_impl<false>;
+      using const_iterator = iterator_impl<true>;
+
+      chunked() = default;
+
+      chunked(const chunked& other)
+      {
+         for (auto& x : other) {
+            push_back(x);
+         }
+      }
+
+      chunked(chunked&& other) noexcept { swap(other); }
+
+      chunked& operator=(const chunked& other)
+      {
+         if (this != &other) {
+            clear();
+            for (auto& x : other) {
+               push_back(x);
+            }
+         }
+         return *this;
+      }
+
+      chunked& operator=(chunked&& other) noexcept
+      {
+         chunked tmp{std::move(other)};
+         swap(tmp);
+         return *this;
+      }
+
+      ~chunked() { clear(); }
+
+      void swap(chunked& other) noexcept
+      {
+         std::swap(blocks, other.blocks);
+         std::swap(cursor, other.cursor);
+         std::swap(limit, other.limit);
+      }
+
+      template <class... Args>
+      T& emplace_back(Args&&... args)
+      {
+         if (cursor == limit) [[unlikely]] {
+            add_block();
+         }
+         T* value = std::construct_at(cursor, std::forward<Args>(args)...);
+         ++cursor;
+         return *value;
+      }
+
+      void push_back(const T& value) { emplace_back(value); }
+      void push_back(T&& value) { emplace_back(std::move(value)); }
+
+      void resize(const size_t count)
+      {
+         while (size() > count) {
+            pop_back();
+         }
+         while (size() < count) {
+            emplace_back();
+         }
+      }
+
+      void pop_back() noexcept
+      {
+         std::destroy_at(--cursor);
+         if (cursor == blocks.back()) {
+            shared_block_pool().release(blocks.back());
+            blocks.pop_back();
+            cursor = limit = blocks.empty() ? nullptr : blocks.back() + chunk_size;
+         }
+      }
+
+      void clear() noexcept
+      {
+         if constexpr (!std::is_trivially_destructible_v<T>) {
+            for (auto& x : *this) {
+               std::destroy_at(&x);
+            }
+         }
+         shared_block_pool().release(blocks.begin(), blocks.end());
+         blocks.clear();
+         cursor = limit = nullptr;
+      }
+
+      size_t size() const noexcept
+      {
+         return blocks.empty() ? 0 : (blocks.size() - 1) * chunk_size + static_cast<size_t>(cursor - blocks.back());
+      }
+      bool empty() const noexcept { return cursor == nullptr; }
+
+      T& operator[](const size_t i) noexcept { return blocks[i / chunk_size][i % chunk_size]; }
+      const T& operator[](const size_t i) const noexcept { return blocks[i / chunk_size][i % chunk_size]; }
+
+      T& front() noexcept { return blocks.front()[0]; }
+      const T& front() const noexcept { return blocks.front()[0]; }
+      T& back() noexcept { return cursor[-1]; }
+      const T& back() const noexcept { return cursor[-1]; }
+
+      iterator begin() noexcept { return {blocks.data(), 0}; }
+      iterator end() noexcept { return {blocks.data(), size()}; }
+      const_iterator begin() const noexcept { return {blocks.data(), 0}; }
+      const_iterator end() const noexcept { return {blocks.data(), size()}; }
+
+      // number of blocks held
+      size_t block_count() const noexcept { return blocks.size(); }
+
+      bool operator==(const chunked& other) const { return std::equal(begin(), end(), other.begin(), other.end()); }
+
+     private:
+      std::vector<T*> blocks{};
+      // next free slot and end of the last block
+      T* cursor{};
+      T* limit{};
+
+      void add_block()
+      {
+         blocks.emplace_back(static_cast<T*>(shared_block_pool().allocate()));
+         cursor = blocks.back();
+         limit = cursor + chunk_size;
+      }
+   };
+}
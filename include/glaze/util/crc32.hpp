@@ -0,0 +1,65 @@
+// Glaze Library
+// For the license information refer to glaze.hpp
+
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "glaze/util/endian.hpp"
+
+// CRC-32 (IEEE 802.3, reflected polynomial 0xEDB88320), as used by zlib and PNG
+
+namespace glz
+{
+   namespace detail
+   {
+      // slicing by eight tables, table k advances a byte through k further zero bytes
+      inline constexpr auto crc32_tables = [] {
+         std::array<std::array<uint32_t, 256>, 8> t{};
+         for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t c = i;
+            for (size_t k = 0; k < 8; ++k) {
+               c = (c & 1) ? (c >> 1) ^ 0xEDB88320u : c >> 1;
+            }
+            t[0][i] = c;
+         }
+         for (uint32_t i = 0; i < 256; ++i) {
+            for (size_t k = 1; k < 8; ++k) {
+               t[k][i] = (t[k - 1][i] >> 8) ^ t[0][t[k - 1][i] & 0xff];
+            }
+         }
+         return t;
+      }();
+   }
+
+   /// <summary>
+   /// CRC-32 of a byte range, pass a previous result as crc to continue a running checksum
+   /// eight bytes are folded per step through independent table lookups
+   /// </summary>
+   inline uint32_t crc32(const void* data, size_t n, uint32_t crc = 0) noexcept
+   {
+      const auto& t = detail::crc32_tables;
+      auto p = static_cast<const unsigned char*>(data);
+      crc = ~crc;
+      for (; n >= 8; n -= 8, p += 8) {
+         uint32_t lo, hi;
+         std::memcpy(&lo, p, 4);
+         std::memcpy(&hi, p + 4, 4);
+         if constexpr (std::endian::native == std::endian::big) {
+            lo = detail::byteswap(lo);
+            hi = detail::byteswap(hi);
+         }
+         lo ^= crc;
+         crc = t[7][lo & 0xff] ^ t[6][(lo >> 8) & 0xff] ^ t[5][(lo >> 16) & 0xff] ^ t[4][lo >> 24] ^
+               t[3][hi & 0xff] ^ t[2][(hi >> 8) & 0xff] ^ t[1][(hi >> 16) & 0xff] ^ t[0][hi >> 24];
+      }
+      for (; n > 0; --n, ++p) {
+         crc = (crc >> 8) ^ t[0][(crc ^ *p) & 0xff];
+      }
+      return ~crc;
+   }
+}
@@ -0,0 +1,92 @@
+// Glaze Library
+// For the license information refer to glaze.hpp
+
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace glz::detail
+{
+   template <class T>
+   inline constexpr T byteswap(const T x) noexcept
+   {
+      static_assert(std::is_integral_v<T>);
+      if constexpr (sizeof(T) == 1) {
+         return x;
+      }
+#if defined(__GNUC__) || defined(__clang__)
+      else if constexpr (sizeof(T) == 2) {
+         return static_cast<T>(__builtin_bswap16(static_cast<uint16_t>(x)));
+      }
+      else if constexpr (sizeof(T) == 4) {
+         return static_cast<T>(__builtin_bswap32(static_cast<uint32_t>(x)));
+      }
+      else if constexpr (sizeof(T) == 8) {
+         return static_cast<T>(__builtin_bswap64(static_cast<uint64_t>(x)));
+      }
+#endif
+      else {
+         using U = std::make_unsigned_t<T>;
+         U in = static_cast<U>(x);
+         U out{};
+         for (size_t i = 0; i < sizeof(T); ++i) {
+            out = static_cast<U>((out << 8) | (in & 0xff));
+            in = static_cast<U>(in >> 8);
+         }
+         return static_cast<T>(out);
+      }
+   }
+
+   template <size_t N>
+   struct unsigned_of_size;
+
+   template <>
+   struct unsigned_of_size<1> { using type = uint8_t; };
+   template <>
+   struct unsigned_of_size<2> { using type = uint16_t; };
+   template <>
+   struct unsigned_of_size<4> { using type = uint32_t; };
+   template <>
+   struct unsigned_of_size<8> { using type = uint64_t; };
+
+   // swaps the bytes of any arithmetic or enum value through an unsigned integer of the same size
+   template <class T>
+   inline T byteswap_value(const T x) noexcept
+   {
+      if constexpr (sizeof(T) == 1) {
+         return x;
+      }
+      else {
+         using U = typename unsigned_of_size<sizeof(T)>::type;
+         U u;
+         std::memcpy(&u, &x, sizeof(T));
+         u = byteswap(u);
+         T ret;
+         std::memcpy(&ret, &u, sizeof(T));
+         return ret;
+      }
+   }
+
+   /// <summary>
+   /// swaps the bytes of every element of a contiguous array in place
+   /// The loop has no dependencies between elements and is written so that compilers emit vector shuffles for it.
+   /// </summary>
+   template <class T>
+   inline void byteswap_array(T* data, const size_t n) noexcept
+   {
+      if constexpr (sizeof(T) > 1) {
+         using U = typename unsigned_of_size<sizeof(T)>::type;
+         auto* bytes = reinterpret_cast<std::byte*>(data);
+         for (size_t i = 0; i < n; ++i) {
+            U u;
+            std::memcpy(&u, bytes + i * sizeof(T), sizeof(T));
+            u = byteswap(u);
+            std::memcpy(bytes + i * sizeof(T), &u, sizeof(T));
+         }
+      }
+   }
+}
@@ -0,0 +1,342 @@
+// Glaze Library
+// For the license information refer to glaze.hpp
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+#include "glaze/util/varint.hpp"
+
+// Gorilla style time series compression (Pelkonen et al., "Gorilla: A Fast, Scalable, In-Memory Time Series Database")
+// Floating point values are XORed with the previous value and only the meaningful bits are stored, integers store the
+// delta of their deltas in variable width buckets. Smooth or slowly changing signals shrink to a few bits per sample.
+
+namespace glz
+{
+   namespace detail
+   {
+      // bits are packed from the most significant end of each word
+      struct bit_writer
+      {
+         std::vector<uint64_t> words{};
+         size_t bits{};
+
+         // writes the low n bits of value, 1 <= n <= 64
+         void write(uint64_t value, const uint32_t n)
+         {
+            if (n < 64) {
+               value &= (uint64_t(1) << n) - 1;
+            }
+            const uint32_t used = bits & 63;
+            if (used == 0) {
+               words.push_back(0);
+            }
+            const uint32_t free = 64 - used;
+            if (n <= free) {
+               words.back() |= value << (free - n);
+            }
+            else {
+               const uint32_t rest = n - free;
+               words.back() |= value >> rest;
+               words.push_back(value << (64 - rest));
+            }
+            bits += n;
+         }
+
+         void write_bit(const bool bit) { write(uint64_t(bit), 1); }
+      };
+
+      // reads at most bits bits, a read of zero bits or past the end sets failed and returns 0
+      struct bit_reader
+      {
+         const uint64_t* words{};
+         size_t bits{};
+         size_t pos{};
+         bool failed{};
+
+         uint64_t read(const uint32_t n) noexcept
+         {
+            if (n == 0 || n > 64 || n > bits - pos) [[unlikely]] {
+               failed = true;
+               pos = bits;
+               return 0;
+            }
+            const size_t word = pos >> 6;
+            const uint32_t offset = pos & 63;
+            const uint32_t avail = 64 - offset;
+            pos += n;
+            if (n <= avail) {
+               return (words[word] << offset) >> (64 - n);
+            }
+            const uint32_t rest = n - avail;
+            const uint64_t first = words[word] & ((uint64_t(1) << avail) - 1);
+            return (first << rest) | (words[word + 1] >> (64 - rest));
+         }
+
+         bool read_bit() noexcept { return read(1); }
+      };
+
+      template <class T>
+      concept gorilla_value = std::is_arithmetic_v<T> && !std::same_as<T, bool>;
+
+      // state shared by the encoder and decoder, the decoder replays the encoder's decisions
+      template <gorilla_value T>
+      struct gorilla_state
+      {
+         static constexpr bool floating = std::floating_point<T>;
+         using U = std::conditional_t<floating && sizeof(T) == 4, uint32_t, uint64_t>;
+         static constexpr uint32_t W = sizeof(U) * 8;
+
+         size_t count{};
+         U prev{};
+         // floating point: window of meaningful bits of the previous XOR
+         uint32_t lead = W;
+         uint32_t trail{};
+         // integers: previous delta
+         uint64_t delta{};
+
+         static U to_bits(const T value) noexcept
+         {
+            if constexpr (floating) {
+               U u;
+               std::memcpy(&u, &value, sizeof(T));
+               return u;
+            }
+            else {
+               return static_cast<U>(static_cast<std::make_unsigned_t<T>>(value));
+            }
+         }
+
+         static T from_bits(const U u) noexcept
+         {
+            if constexpr (floating) {
+               T value;
+               std::memcpy(&value, &u, sizeof(T));
+               return value;
+            }
+            else {
+               return static_cast<T>(u);
+            }
+         }
+
+         void encode(bit_writer& w, const T value)
+         {
+            const U bits = to_bits(value);
+            if (count == 0) {
+               w.write(bits, W);
+            }
+            else if constexpr (floating) {
+               const U x = bits ^ prev;
+               if (x == 0) {
+                  w.write_bit(0);
+               }
+               else {
+                  w.write_bit(1);
+                  const uint32_t l = std::min(uint32_t(std::countl_zero(x)), uint32_t{31});
+                  const uint32_t t = std::countr_zero(x);
+                  if (lead != W && l >= lead && t >= trail) {
+                     w.write_bit(0);
+                     w.write(x >> trail, W - lead - trail);
+                  }
+                  else {
+                     const uint32_t sig = W - l - t;
+                     w.write_bit(1);
+                     w.write(l, 5);
+                     w.write(sig - 1, 6);
+                     w.write(x >> t, sig);
+                     lead = l;
+                     trail = t;
+                  }
+               }
+            }
+            else {
+               const uint64_t d = bits - prev;
+               const uint64_t z = zigzag_encode(static_cast<int64_t>(d - delta));
+               if (z == 0) {
+                  w.write_bit(0);
+               }
+               else if (z < (1 << 7)) {
+                  w.write(0b10, 2);
+                  w.write(z, 7);
+               }
+               else if (z < (1 << 9)) {
+                  w.write(0b110, 3);
+                  w.write(z, 9);
+               }
+               else if (z < (1 << 12)) {
+                  w.write(0b1110, 4);
+                  w.write(z, 12);
+               }
+               else {
+                  w.write(0b1111, 4);
+                  w.write(z, 64);
+               }
+               delta = d;
+            }
+            prev = bits;
+            ++count;
+         }
+
+         T decode(bit_reader& r) noexcept
+         {
+            if (count == 0) {
+               prev = static_cast<U>(r.read(W));
+            }
+            else if constexpr (floating) {
+               if (r.read_bit()) {
+                  if (r.read_bit()) {
+                     lead = static_cast<uint32_t>(r.read(5));
+                     const auto sig = static_cast<uint32_t>(r.read(6)) + 1;
+                     if (lead + sig > W) [[unlikely]] {
+                        r.failed = true;
+                        return from_bits(prev);
+                     }
+                     trail = W - lead - sig;
+                  }
+                  prev ^= static_cast<U>(r.read(W - lead - trail) << trail);
+               }
+            }
+            else {
+               uint64_t z = 0;
+               if (r.read_bit()) {
+                  if (!r.read_bit()) {
+                     z = r.read(7);
+                  }
+                  else if (!r.read_bit()) {
+                     z = r.read(9);
+                  }
+                  else if (!r.read_bit()) {
+                     z = r.read(12);
+                  }
+                  else {
+                     z = r.read(64);
+                  }
+               }
+               delta += static_cast<uint64_t>(zigzag_decode(z));
+               prev += delta;
+            }
+            ++count;
+            return from_bits(prev);
+         }
+      };
+   }
+
+   /// <summary>
+   /// append only sequence of numbers stored Gorilla compressed
+   /// values are decoded sequentially through iteration, use it as a recorder channel with glz::recorder<glz::compressed<double>>
+   /// </summary>
+   template <detail::gorilla_value T>
+   struct compressed
+   {
+      using value_type = T;
+      using size_type = size_t;
+
+      struct const_iterator
+      {
+         using iterator_category = std::input_iterator_tag;
+         using value_type = T;
+         using difference_type = std::ptrdiff_t;
+         using reference = T;
+         using pointer = void;
+
+         detail::bit_reader reader{};
+         detail::gorilla_state<T> state{};
+         size_t index{};
+         size_t n{};
+         T value{};
+
+         const_iterator() = default;
+
+         const_iterator(const uint64_t* words, const size_t bits, const size_t index, const size_t n)
+            : reader{words, bits}, index(index), n(n)
+         {
+            if (index < n) {
+               value = state.decode(reader);
+            }
+         }
+
+         T operator*() const noexcept { return value; }
+
+         const_iterator& operator++() noexcept
+         {
+            ++index;
+            if (index < n) {
+               value = state.decode(reader);
+            }
+            return *this;
+         }
+
+         const_iterator operator++(int) noexcept
+         {
+            auto ret = *this;
+            ++*this;
+            return ret;
+         }
+
+         bool operator==(const const_iterator& other) const noexcept { return index == other.index; }
+      };
+
+      void push_back(const T value) { state.encode(stream, value); }
+
+      void emplace_back(const T value) { push_back(value); }
+
+      size_t size() const noexcept { return state.count; }
+      bool empty() const noexcept { return state.count == 0; }
+
+      void clear() noexcept
+      {
+         stream = {};
+         state = {};
+      }
+
+      const_iterator begin() const { return {stream.words.data(), stream.bits, 0, size()}; }
+      const_iterator end() const { return {stream.words.data(), stream.bits, size(), size()}; }
+
+      T back() const noexcept { return detail::gorilla_state<T>::from_bits(state.prev); }
+
+      // compressed stream, for serialization
+      const std::vector<uint64_t>& words() const noexcept { return stream.words; }
+      size_t bit_size() const noexcept { return stream.bits; }
+
+      // bytes used by the compressed stream
+      size_t memory() const noexcept { return stream.words.size() * sizeof(uint64_t); }
+
+      // adopts a stream of n values, replaying it so that further values can be appended
+      // returns false and leaves the sequence empty if the stream does not hold n valid values
+      bool assign(std::vector<uint64_t> words, const size_t bits, const size_t n)
+      {
+         clear();
+         if (bits > words.size() * 64) {
+            return false;
+         }
+         detail::bit_reader reader{words.data(), bits};
+         for (size_t i = 0; i < n && !reader.failed; ++i) {
+            state.decode(reader);
+         }
+         if (reader.failed) {
+            state = {};
+            return false;
+         }
+         stream.words = std::move(words);
+         stream.bits = bits;
+         return true;
+      }
+
+     private:
+      detail::bit_writer stream{};
+      detail::gorilla_state<T> state{};
+   };
+
+   template <class T>
+   inline constexpr bool is_compressed_v = false;
+
+   template <class T>
+   inline constexpr bool is_compressed_v<compressed<T>> = true;
+}
@@ -0,0 +1,177 @@
+// Glaze Library
+// For the license information refer to glaze.hpp
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace glz
+{
+   /// <summary>
+   /// fixed capacity sequence that overwrites its oldest value once full
+   /// the storage is allocated when the ring is constructed and appending is O(1) with no allocation, so memory stays
+   /// flat however long a run lasts
+   /// iteration goes from the oldest to the newest value, use it as a recorder channel with glz::recorder<glz::ring<double>>
+   /// </summary>
+   template <class T>
+   struct ring
+   {
+      using value_type = T;
+      using size_type = size_t;
+      using difference_type = std::ptrdiff_t;
+      using reference = T&;
+      using const_reference = const T&;
+
+      template <bool Const>
+      struct iterator_impl
+      {
+         using iterator_category = std::random_access_iterator_tag;
+         using value_type = T;
+         using difference_type = std::ptrdiff_t;
+         using reference = std::conditional_t<Const, const T&, T&>;
+         using pointer = std::conditional_t<Const, const T*, T*>;
+
+         pointer data{};
+         size_t capacity{};
+         size_t first{}; // slot of the oldest value
+         size_t index{};
+
+         iterator_impl() = default;
+         iterator_impl(pointer data, const size_t capacity, const size_t first, const size_t index) noexcept
+            : data(data), capacity(capacity), first(first), index(index)
+         {}
+
+         template <bool C = Const>
+         requires C
+         iterator_impl(const iterator_impl<false>& other) noexcept
+            : data(other.data), capacity(other.capacity), first(other.first), index(other.index)
+         {}
+
+         reference operator*() const noexcept
+         {
+            const auto slot = first + index;
+            return data[slot < capacity ? slot : slot - capacity];
+         }
+         pointer operator->() const noexcept { return &**this; }
+         reference operator[](const difference_type n) const noexcept { return *(*this + n); }
+
+         iterator_impl& operator++() noexcept
+         {
+            ++index;
+            return *this;
+         }
+         iterator_impl operator++(int) noexcept
+         {
+            auto ret = *this;
+            ++index;
+            return ret;
+         }
+         iterator_impl& operator--() noexcept
+         {
+            --index;
+            return *this;
+         }
+         iterator_impl operator--(int) noexcept
+         {
+            auto ret = *this;
+            --index;
+            return ret;
+         }
+         iterator_impl& operator+=(const difference_type n) noexcept
+         {
+            index += n;
+            return *this;
+         }
+         iterator_impl& operator-=(const difference_type n) noexcept
+         {
+            index -= n;
+            return *this;
+         }
+         friend iterator_impl operator+(iterator_impl it, const difference_type n) noexcept { return it += n; }
+         friend iterator_impl operator+(const difference_type n, iterator_impl it) noexcept { return it += n; }
+         friend iterator_impl operator-(iterator_impl it, const difference_type n) noexcept { return it -= n; }
+         friend difference_type operator-(const iterator_impl& a, const iterator_impl& b) noexcept
+         {
+            return static_cast<difference_type>(a.index) - static_cast<difference_type>(b.index);
+         }
+         bool operator==(const iterator_impl& other) const noexcept { return index == other.index; }
+         auto operator<=>(const iterator_impl& other) const noexcept { return index <=> other.index; }
+      };
+
+      using iterator = iterator_impl<false>;
+      using const_iterator = iterator_impl<true>;
+
+      ring() = default;
+      explicit ring(const size_t capacity) : buffer(capacity) {}
+
+      template <class... Args>
+      void emplace_back(Args&&... args)
+      {
+         // a ring without capacity keeps nothing
+         if (buffer.empty()) [[unlikely]] {
+            return;
+         }
+         buffer[next] = T(std::forward<Args>(args)...);
+         next = next + 1 == buffer.size() ? 0 : next + 1;
+         if (count < buffer.size()) {
+            ++count;
+         }
+      }
+
+      void push_back(const T& value) { emplace_back(value); }
+      void push_back(T&& value) { emplace_back(std::move(value)); }
+
+      // used when reading a snapshot, this allocates and grows the capacity to n if needed so that no value is dropped
+      // shrinking keeps the newest values
+      void resize(const size_t n)
+      {
+         if (n == count) {
+            return;
+         }
+         std::vector<T> values(std::max(n, buffer.size()));
+         const auto kept = std::min(n, count);
+         std::move(end() - kept, end(), values.begin());
+         buffer = std::move(values);
+         count = n;
+         next = n == buffer.size() ? 0 : n;
+      }
+
+      void clear() noexcept
+      {
+         next = 0;
+         count = 0;
+      }
+
+      size_t size() const noexcept { return count; }
+      bool empty() const noexcept { return count == 0; }
+      size_t capacity() const noexcept { return buffer.size(); }
+      bool full() const noexcept { return count == buffer.size(); }
+
+      T& operator[](const size_t i) noexcept { return begin()[i]; }
+      const T& operator[](const size_t i) const noexcept { return begin()[i]; }
+
+      T& front() noexcept { return *begin(); }
+      const T& front() const noexcept { return *begin(); }
+      T& back() noexcept { return buffer[next ? next - 1 : buffer.size() - 1]; }
+      const T& back() const noexcept { return buffer[next ? next - 1 : buffer.size() - 1]; }
+
+      iterator begin() noexcept { return {buffer.data(), buffer.size(), oldest(), 0}; }
+      iterator end() noexcept { return {buffer.data(), buffer.size(), oldest(), count}; }
+      const_iterator begin() const noexcept { return {buffer.data(), buffer.size(), oldest(), 0}; }
+      const_iterator end() const noexcept { return {buffer.data(), buffer.size(), oldest(), count}; }
+
+      bool operator==(const ring& other) const { return std::equal(begin(), end(), other.begin(), other.end()); }
+
+     private:
+      std::vector<T> buffer{};
+      size_t next{}; // slot written by the next append
+      size_t count{};
+
+      size_t oldest() const noexcept { return count == buffer.size() ? next : next - count; }
+   };
+}
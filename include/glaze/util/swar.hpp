@@ -0,0 +1,127 @@
+// Glaze Library
+// For the license information refer to glaze.hpp
+
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// SIMD within a register (SWAR)
+// Byte classification over 8 bytes at a time with plain 64 bit integer operations. This gives us vectorized string
+// region masks without depending on platform specific intrinsics.
+
+namespace glz::detail
+{
+   inline constexpr uint64_t repeat_byte(const uint8_t c) noexcept { return 0x0101010101010101ull * c; }
+
+   inline constexpr uint64_t high_bits = repeat_byte(0x80);
+   inline constexpr uint64_t low_bits = repeat_byte(0x7f);
+
+   inline uint64_t load_u64(const char* p) noexcept
+   {
+      uint64_t chunk;
+      std::memcpy(&chunk, p, 8);
+      return chunk;
+   }
+
+   // the high bit of each byte is set where the byte is zero, with no false positives
+   inline constexpr uint64_t zero_bytes(const uint64_t chunk) noexcept
+   {
+      return ~(((chunk & low_bits) + low_bits) | chunk | low_bits);
+   }
+
+   // the high bit of each byte is set where the byte equals c
+   template <char c>
+   inline constexpr uint64_t match_bytes(const uint64_t chunk) noexcept
+   {
+      return zero_bytes(chunk ^ repeat_byte(static_cast<uint8_t>(c)));
+   }
+
+   // the high bit of each byte is set where the (unsigned) byte is less than n, n must be <= 128
+   template <uint8_t n>
+   inline constexpr uint64_t less_than_bytes(const uint64_t chunk) noexcept
+   {
+      static_assert(n <= 128);
+      return ~(((chunk & low_bits) + repeat_byte(0x80 - n)) | chunk) & high_bits;
+   }
+
+   // index of the first flagged byte in memory order for a non-zero mask
+   inline constexpr size_t first_byte(const uint64_t mask) noexcept
+   {
+      if constexpr (std::endian::native == std::endian::little) {
+         return static_cast<size_t>(std::countr_zero(mask)) >> 3;
+      }
+      else {
+         return static_cast<size_t>(std::countl_zero(mask)) >> 3;
+      }
+   }
+
+   // clears the first flagged byte in memory order
+   inline constexpr uint64_t clear_first_byte(const uint64_t mask) noexcept
+   {
+      if constexpr (std::endian::native == std::endian::little) {
+         return mask & (mask - 1);
+      }
+      else {
+         return mask & ~(uint64_t{0x80} << (56 - 8 * first_byte(mask)));
+      }
+   }
+
+   // gathers the flag of each byte into one bit, bit i is the byte at memory offset i
+   inline constexpr uint64_t movemask(const uint64_t mask) noexcept
+   {
+      const uint64_t bits = ((mask >> 7) * 0x0102040810204080ull) >> 56;
+      if constexpr (std::endian::native == std::endian::little) {
+         return bits;
+      }
+      else {
+         // bit i holds the byte at offset 7 - i
+         uint64_t reversed = 0;
+         for (size_t i = 0; i < 8; ++i) {
+            reversed |= ((bits >> i) & 1) << (7 - i);
+         }
+         return reversed;
+      }
+   }
+
+   // bit i is the xor of bits 0 through i, turns a mask of quote positions into a mask of quoted regions
+   inline constexpr uint64_t prefix_xor(uint64_t x) noexcept
+   {
+      x ^= x << 1;
+      x ^= x << 2;
+      x ^= x << 4;
+      x ^= x << 8;
+      x ^= x << 16;
+      x ^= x << 32;
+      return x;
+   }
+
+   /// <summary>
+   /// returns a pointer to the first character in [it, end) that is one of Cs, or a control/whitespace character
+   /// (<= ' ') when Whitespace is true, returns end if none is found
+   /// </summary>
+   template <bool Whitespace, char... Cs>
+   inline const char* find_first_of(const char* it, const char* end) noexcept
+   {
+      for (; it + 8 <= end; it += 8) {
+         const auto chunk = load_u64(it);
+         uint64_t mask = (match_bytes<Cs>(chunk) | ... | 0);
+         if constexpr (Whitespace) {
+            mask |= less_than_bytes<0x21>(chunk);
+         }
+         if (mask) {
+            return it + first_byte(mask);
+         }
+      }
+
+      for (; it < end; ++it) {
+         const auto c = *it;
+         if (((c == Cs) || ...) || (Whitespace && static_cast<uint8_t>(c) < 0x21)) {
+            return it;
+         }
+      }
+      return end;
+   }
+}
@@ -12,6 +12,12 @@ namespace glz
    template <class T>
    concept is_variant = is_specialization_v<T, std::variant>;
    
+   template <class Variant, class T>
+   inline constexpr bool variant_holds_v = false;
+   
+   template <class... Ts, class T>
+   inline constexpr bool variant_holds_v<std::variant<Ts...>, T> = (std::same_as<Ts, T> || ...);
+   
    template <class... T>
    auto to_variant_pointer(std::variant<T...>&&)
    {
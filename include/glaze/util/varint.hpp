@@ -0,0 +1,117 @@
+// Glaze Library
+// For the license information refer to glaze.hpp
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "glaze/util/swar.hpp"
+
+// LEB128 variable length integers with zigzag mapping for signed values
+
+namespace glz::detail
+{
+   inline constexpr size_t max_varint_bytes = 10;
+
+   inline constexpr uint64_t zigzag_encode(const int64_t x) noexcept
+   {
+      return (static_cast<uint64_t>(x) << 1) ^ static_cast<uint64_t>(x >> 63);
+   }
+
+   inline constexpr int64_t zigzag_decode(const uint64_t x) noexcept
+   {
+      return static_cast<int64_t>((x >> 1) ^ (~(x & 1) + 1));
+   }
+
+   // maps an integer to the unsigned value that is varint encoded, signed values are zigzagged so that small
+   // magnitudes stay small
+   template <class I>
+   inline constexpr uint64_t to_varint(const I x) noexcept
+   {
+      if constexpr (std::is_signed_v<I>) {
+         return zigzag_encode(static_cast<int64_t>(x));
+      }
+      else {
+         return static_cast<uint64_t>(x);
+      }
+   }
+
+   template <class I>
+   inline constexpr I from_varint(const uint64_t x) noexcept
+   {
+      if constexpr (std::is_signed_v<I>) {
+         return static_cast<I>(zigzag_decode(x));
+      }
+      else {
+         return static_cast<I>(x);
+      }
+   }
+
+   inline uint8_t* encode_varint(uint64_t x, uint8_t* out) noexcept
+   {
+      while (x >= 0x80) {
+         *out = static_cast<uint8_t>(x) | 0x80;
+         ++out;
+         x >>= 7;
+      }
+      *out = static_cast<uint8_t>(x);
+      return out + 1;
+   }
+
+   inline const uint8_t* decode_varint(const uint8_t* it, const uint8_t* end, uint64_t& x) noexcept
+   {
+      x = 0;
+      for (uint32_t shift = 0; it < end && shift < 64; shift += 7) {
+         const auto byte = *it;
+         ++it;
+         x |= uint64_t(byte & 0x7f) << shift;
+         if (!(byte & 0x80)) {
+            break;
+         }
+      }
+      return it;
+   }
+
+   /// <summary>
+   /// decodes n varints, calling emit for each value
+   /// Eight bytes are classified at a time: every byte before the first continuation bit is a complete single byte
+   /// value and is emitted without further branching, only multi byte values go through the scalar decoder.
+   /// </summary>
+   template <class F>
+   inline const uint8_t* decode_varints(const uint8_t* it, const uint8_t* end, size_t n, F&& emit) noexcept
+   {
+      while (n) {
+         if (n >= 8 && end - it >= 8) {
+            const auto continuation = load_u64(reinterpret_cast<const char*>(it)) & high_bits;
+            if (continuation == 0) {
+               for (size_t i = 0; i < 8; ++i) {
+                  emit(uint64_t(it[i]));
+               }
+               it += 8;
+               n -= 8;
+               continue;
+            }
+            const auto k = first_byte(continuation);
+            if (k) {
+               for (size_t i = 0; i < k; ++i) {
+                  emit(uint64_t(it[i]));
+               }
+               it += k;
+               n -= k;
+               continue;
+            }
+         }
+         if (it == end) [[unlikely]] {
+            break;
+         }
+
+         uint64_t x;
+         it = decode_varint(it, end, x);
+         emit(x);
+         --n;
+      }
+      return it;
+   }
+}
@@ -14,6 +14,10 @@
 
 #include "glaze/binary/write.hpp"
 #include "glaze/binary/read.hpp"
+#include "glaze/binary/view.hpp"
+#include "glaze/binary/size.hpp"
+#include "glaze/binary/log.hpp"
+#include "glaze/record/recorder_binary.hpp"
 
 using namespace glz;
 
@@ -370,6 +374,50 @@ void write_tests()
    };
 }
 
+void parallel_write_tests()
+{
+   using namespace boost::ut;
+   
+   "parallel vector write"_test = [] {
+      std::vector<my_struct> v(20000);
+      for (size_t i = 0; i < v.size(); ++i) {
+         v[i].i = static_cast<int>(i);
+      }
+      
+      glz::pool pool{4};
+      glz::context ctx{};
+      ctx.thread_pool = &pool;
+      
+      std::string serial{};
+      glz::write_binary(v, serial);
+      std::string parallel{};
+      glz::write<glz::opts{.format = glz::binary, .parallel = true}>(v, parallel, ctx);
+      expect(parallel == serial);
+      
+      std::vector<my_struct> v2{};
+      glz::read_binary(v2, parallel);
+      expect(v2.size() == v.size());
+      expect(v2.back().i == v.back().i);
+   };
+   
+   "parallel map write"_test = [] {
+      std::map<int, double> m;
+      for (int i = 0; i < 10000; ++i) {
+         m[i] = i * 1.5;
+      }
+      
+      glz::pool pool{4};
+      glz::context ctx{};
+      ctx.thread_pool = &pool;
+      
+      std::string serial{};
+      glz::write_binary(m, serial);
+      std::string parallel{};
+      glz::write<glz::opts{.format = glz::binary, .parallel = true}>(m, parallel, ctx);
+      expect(parallel == serial);
+   };
+}
+
 void bench()
 {
    using namespace boost::ut;
@@ -561,12 +609,1244 @@ void file_include_test()
    expect(obj.i == 55) << obj.i;
 }
 
+struct optional_int_t
+{
+   std::optional<int32_t> x{};
+};
+
+template <>
+struct glz::meta<optional_int_t>
+{
+   static constexpr auto value = object("x", &optional_int_t::x);
+};
+
+struct optional_double_t
+{
+   std::optional<double> x{};
+};
+
+template <>
+struct glz::meta<optional_double_t>
+{
+   static constexpr auto value = object("x", &optional_double_t::x);
+};
+
+void trusted_layout_tests()
+{
+   using namespace boost::ut;
+   
+   static constexpr glz::opts trusted{.format = glz::binary, .trusted_layout = true};
+   
+   "trusted layout round trip"_test = [] {
+      Thing obj{};
+      obj.thing.a = 5.7;
+      obj.thing2array[0].b = "changed";
+      obj.i = 77;
+      obj.color = Color::Blue;
+      obj.map["z"] = 26;
+      
+      std::string s{};
+      glz::write<trusted>(obj, s);
+      
+      Thing obj2{};
+      glz::read<trusted>(obj2, s);
+      expect(obj2.thing.a == 5.7);
+      expect(obj2.thing2array[0].b == "changed");
+      expect(obj2.i == 77);
+      expect(obj2.color == Color::Blue);
+      expect(obj2.map == obj.map);
+      expect(obj2.vb == obj.vb);
+   };
+   
+   "trusted layout reads keyed messages"_test = [] {
+      my_struct obj{};
+      obj.i = 12;
+      obj.hello = "keyed";
+      std::string s{};
+      glz::write_binary(obj, s);
+      
+      my_struct obj2{};
+      glz::read<trusted>(obj2, s);
+      expect(obj2.i == 12);
+      expect(obj2.hello == "keyed");
+   };
+   
+   "trusted layout is smaller"_test = [] {
+      my_struct obj{};
+      std::string keyed{};
+      glz::write_binary(obj, keyed);
+      std::string positional{};
+      glz::write<trusted>(obj, positional);
+      // one 8 byte layout hash replaces the count header and four 4 byte key hashes
+      expect(positional.size() + 9 == keyed.size());
+   };
+   
+   "layout hash"_test = [] {
+      expect(glz::layout_hash_v<my_struct> != glz::layout_hash_v<sub_thing>);
+      expect(glz::layout_hash_v<sub_thing> != glz::layout_hash_v<sub_thing2>);
+      expect(glz::layout_hash_v<Thing> == glz::layout_hash_v<const Thing&>);
+      // everything that changes the bytes on the wire changes the hash
+      expect(glz::layout_hash_v<optional_int_t> != glz::layout_hash_v<optional_double_t>);
+      expect(glz::layout_hash_v<std::array<int32_t, 2>> != glz::layout_hash_v<std::array<int32_t, 4>>);
+      expect(glz::layout_hash_v<std::array<int32_t, 2>> != glz::layout_hash_v<std::vector<int32_t>>);
+      expect(glz::layout_hash_v<std::variant<int32_t, double>> != glz::layout_hash_v<std::variant<int32_t, float>>);
+      expect(glz::layout_hash_v<std::vector<int32_t>> == glz::layout_hash_v<std::deque<int32_t>>);
+   };
+   
+   "trusted layout rejects a different payload"_test = [] {
+      optional_int_t obj{42};
+      std::string s{};
+      glz::write<trusted>(obj, s);
+      // the hashes differ, so the bytes of the int are never decoded as a double
+      optional_double_t obj2{};
+      try {
+         glz::read<trusted>(obj2, s);
+      }
+      catch (const std::exception&) {
+      }
+      expect(!obj2.x.has_value());
+   };
+}
+
+struct my_struct_v2
+{
+   int i = 287;
+   std::vector<double> added{1.0, 2.0, 3.0};
+   double d = 3.14;
+   Thing thing{};
+   std::string hello = "Hello World";
+   std::array<uint64_t, 3> arr = {1, 2, 3};
+   std::string padding = std::string(20000, 'p');
+};
+
+template <>
+struct glz::meta<my_struct_v2>
+{
+   using T = my_struct_v2;
+   static constexpr auto value = object("i", &T::i,          //
+                                        "added", &T::added,  //
+                                        "d", &T::d,          //
+                                        "thing", &T::thing,  //
+                                        "hello", &T::hello,  //
+                                        "arr", &T::arr,      //
+                                        "padding", &T::padding);
+};
+
+void length_prefixed_tests()
+{
+   using namespace boost::ut;
+   
+   static constexpr glz::opts sized{.format = glz::binary, .length_prefixed = true};
+   
+   "length prefixed round trip"_test = [] {
+      Thing obj{};
+      obj.thing.b = "prefixed";
+      obj.vector.resize(100);
+      std::string s{};
+      glz::write<sized>(obj, s);
+      
+      Thing obj2{};
+      glz::read<sized>(obj2, s);
+      expect(obj2.thing.b == "prefixed");
+      expect(obj2.vector.size() == 100);
+      expect(obj2.map == obj.map);
+   };
+   
+   "length prefixed skips unknown members"_test = [] {
+      my_struct_v2 v2{};
+      v2.i = 5;
+      v2.d = 9.5;
+      v2.hello = "newer";
+      v2.arr = {4, 5, 6};
+      
+      std::vector<std::byte> s{};
+      glz::write<sized>(v2, s);
+      
+      my_struct v1{};
+      glz::read<sized>(v1, s);
+      expect(v1.i == 5);
+      expect(v1.d == 9.5);
+      expect(v1.hello == "newer");
+      expect(v1.arr == v2.arr);
+   };
+   
+   "length prefixed push back buffer"_test = [] {
+      static constexpr auto partial = glz::json_ptrs("/i", "/added", "/padding", "/hello");
+      my_struct_v2 v2{};
+      v2.i = 11;
+      v2.hello = "partial";
+      
+      std::vector<std::byte> s{};
+      glz::write<partial, sized>(v2, s);
+      
+      my_struct v1{};
+      glz::read<sized>(v1, s);
+      expect(v1.i == 11);
+      expect(v1.hello == "partial");
+   };
+}
+
+struct tick_view
+{
+   uint8_t flag{};
+   std::string_view symbol{};
+   std::span<const double> prices{};
+   std::span<const int32_t> sizes{};
+};
+
+template <>
+struct glz::meta<tick_view>
+{
+   using T = tick_view;
+   static constexpr auto value = object("flag", &T::flag, "symbol", &T::symbol, "prices", &T::prices, "sizes", &T::sizes);
+};
+
+void view_tests()
+{
+   using namespace boost::ut;
+   
+   static constexpr glz::opts aligned{.format = glz::binary, .aligned_arrays = true};
+   
+   "zero copy views"_test = [] {
+      const std::vector<double> prices{101.5, 101.75, 102.0};
+      const std::vector<int32_t> sizes{100, 200, 300, 400};
+      tick_view in{7, "GLZ", prices, sizes};
+      
+      std::vector<std::byte> buffer{};
+      glz::write<aligned>(in, buffer);
+      
+      tick_view out{};
+      glz::read<aligned>(out, buffer);
+      const auto first = reinterpret_cast<const std::byte*>(buffer.data());
+      const auto last = first + buffer.size();
+      auto inside = [&](const void* p) {
+         const auto b = reinterpret_cast<const std::byte*>(p);
+         return b >= first && b < last;
+      };
+      expect(out.flag == 7);
+      expect(out.symbol == "GLZ");
+      expect(inside(out.symbol.data()));
+      expect(out.prices.size() == 3);
+      expect(out.prices[2] == 102.0);
+      expect(inside(out.prices.data()));
+      expect(reinterpret_cast<uintptr_t>(out.prices.data()) % alignof(double) == 0);
+      expect(out.sizes.size() == 4);
+      expect(out.sizes[3] == 400);
+      expect(reinterpret_cast<uintptr_t>(out.sizes.data()) % alignof(int32_t) == 0);
+   };
+   
+   "aligned arrays read into owning types"_test = [] {
+      my_struct obj{};
+      obj.arr = {7, 8, 9};
+      std::vector<std::byte> buffer{};
+      glz::write<aligned>(obj, buffer);
+      
+      my_struct obj2{};
+      glz::read<aligned>(obj2, buffer);
+      expect(obj2.arr == obj.arr);
+      expect(obj2.hello == obj.hello);
+   };
+   
+   "aligned arrays with length prefixed members"_test = [] {
+      static constexpr glz::opts sized_aligned{.format = glz::binary, .length_prefixed = true, .aligned_arrays = true};
+      const std::vector<double> prices{1.5, 2.5, 3.5};
+      const std::vector<int32_t> sizes{1, 2, 3};
+      tick_view in{3, "xyz", prices, sizes};
+      std::vector<std::byte> buffer{};
+      glz::write<sized_aligned>(in, buffer);
+      expect(glz::serialized_size<sized_aligned>(in) == buffer.size());
+      
+      tick_view out{};
+      glz::read<sized_aligned>(out, buffer);
+      expect(out.prices.size() == 3 && out.prices[2] == 3.5);
+      expect(out.sizes.size() == 3 && out.sizes[1] == 2);
+   };
+   
+   "aligned arrays written in parallel"_test = [] {
+      static constexpr glz::opts parallel_aligned{.format = glz::binary, .parallel = true, .aligned_arrays = true};
+      const std::vector<double> prices{1.0, 2.0, 3.0};
+      std::vector<tick_view> in(5000, tick_view{1, "p", prices, {}});
+      glz::pool pool{4};
+      glz::context ctx{};
+      ctx.thread_pool = &pool;
+      std::vector<std::byte> buffer{};
+      glz::write<parallel_aligned>(in, buffer, ctx);
+      
+      std::vector<tick_view> out{};
+      glz::read<aligned>(out, buffer);
+      expect(out.size() == 5000);
+      expect(out.back().prices.size() == 3 && out.back().prices[1] == 2.0);
+   };
+   
+   "misaligned view throws"_test = [] {
+      const std::vector<double> prices{1.0, 2.0};
+      tick_view in{1, "ab", prices, {}};
+      std::vector<std::byte> buffer{};
+      glz::write_binary(in, buffer);
+      
+      tick_view out{};
+      expect(throws([&] { glz::read_binary(out, buffer); }));
+   };
+}
+
+void offset_table_tests()
+{
+   using namespace boost::ut;
+   
+   static constexpr glz::opts table{.format = glz::binary, .offset_table = true};
+   
+   "offset table round trip"_test = [] {
+      Thing obj{};
+      obj.thing.b = "tabled";
+      obj.vector[1].z = 42.0;
+      obj.mapi[9] = 0.5;
+      std::string s{};
+      glz::write<table>(obj, s);
+      
+      Thing obj2{};
+      glz::read<table>(obj2, s);
+      expect(obj2.thing.b == "tabled");
+      expect(obj2.vector[1].z == 42.0);
+      expect(obj2.mapi == obj.mapi);
+      expect(obj2.list == obj.list);
+      expect(obj2.deque == obj.deque);
+      expect(obj2.array == obj.array);
+   };
+   
+   "binary_view"_test = [] {
+      Thing obj{};
+      obj.thing.a = 1.25;
+      obj.thing2array[0].f = 3.5f;
+      obj.vector[1].z = 42.0;
+      obj.map["b"] = 99;
+      obj.optional = V3{1.0, 2.0, 3.0};
+      std::vector<std::byte> s{};
+      glz::write<table>(obj, s);
+      
+      glz::binary_view<Thing> view{s};
+      expect(view.get<double>("/thing/a") == 1.25);
+      expect(view.get<std::string>("/thing/b") == "stuff");
+      expect(view.get<float>("/thing2array/0/f") == 3.5f);
+      expect(view.get<double>("/vector/1/2") == 42.0);
+      expect(view.get<double>("/deque/1") == 6.7);
+      expect(view.get<int>("/list/3") == 2);
+      expect(view.get<int>("/map/b") == 99);
+      expect(view.get<double>("/mapi/7") == 7.42);
+      expect(view.get<double>("/optional/1") == 2.0);
+      expect(view.get<std::string>("/array/0") == "as\"df\\ghjkl");
+      expect(view.get<Color>("/color") == Color::Green);
+      expect(view.get<V3>("/vec3").x == obj.vec3.x);
+      
+      expect(!view.seek([](auto&&) {}, "/not_a_key"));
+      expect(!view.seek([](auto&&) {}, "/vector/5"));
+      expect(!view.seek([](auto&&) {}, "/map/q"));
+      expect(throws([&] { view.get<int>("/thing/a"); }));
+   };
+   
+   "binary_view with aligned arrays"_test = [] {
+      static constexpr glz::opts aligned_table{.format = glz::binary, .aligned_arrays = true, .offset_table = true};
+      my_struct_v2 obj{};
+      obj.added = {4.0, 5.0, 6.0};
+      std::vector<std::byte> s{};
+      glz::write<aligned_table>(obj, s);
+      
+      glz::binary_view<my_struct_v2, aligned_table> view{s};
+      expect(view.get<double>("/added/2") == 6.0);
+      expect(view.get<uint64_t>("/arr/1") == 2);
+      expect(view.get<std::string>("/hello") == "Hello World");
+   };
+}
+
+struct telemetry
+{
+   std::vector<uint32_t> counts{};
+   std::vector<int64_t> timestamps{};
+   std::vector<int16_t> states{};
+   std::vector<int32_t> raw{};
+};
+
+template <>
+struct glz::meta<telemetry>
+{
+   using T = telemetry;
+   static constexpr auto value = object("counts", glz::varint<&T::counts>,          //
+                                        "timestamps", glz::delta<&T::timestamps>,  //
+                                        "states", glz::rle<&T::states>,            //
+                                        "raw", &T::raw);
+};
+
+struct telemetry_plain
+{
+   std::vector<uint32_t> counts{};
+   std::vector<int64_t> timestamps{};
+   std::vector<int16_t> states{};
+   std::vector<int32_t> raw{};
+};
+
+template <>
+struct glz::meta<telemetry_plain>
+{
+   using T = telemetry_plain;
+   static constexpr auto value =
+      object("counts", &T::counts, "timestamps", &T::timestamps, "states", &T::states, "raw", &T::raw);
+};
+
+void compact_encoding_tests()
+{
+   using namespace boost::ut;
+   
+   "compact integer encodings"_test = [] {
+      telemetry t{};
+      telemetry_plain plain{};
+      for (uint32_t i = 0; i < 1000; ++i) {
+         t.counts.emplace_back(i % 7 == 0 ? i * 100000 : i % 100);
+         t.timestamps.emplace_back(1'600'000'000'000 + 10 * int64_t(i) + (i % 3));
+         t.states.emplace_back(static_cast<int16_t>(i / 250 - 2));
+         t.raw.emplace_back(-int32_t(i));
+      }
+      plain.counts = t.counts;
+      plain.timestamps = t.timestamps;
+      plain.states = t.states;
+      plain.raw = t.raw;
+      
+      std::string compact{};
+      glz::write_binary(t, compact);
+      std::string full{};
+      glz::write_binary(plain, full);
+      expect(compact.size() < full.size() / 2);
+      
+      telemetry t2{};
+      glz::read_binary(t2, compact);
+      expect(t2.counts == t.counts);
+      expect(t2.timestamps == t.timestamps);
+      expect(t2.states == t.states);
+      expect(t2.raw == t.raw);
+   };
+   
+   "compact encoding extremes"_test = [] {
+      telemetry t{};
+      t.counts = {0, 1, 127, 128, 16383, 16384, std::numeric_limits<uint32_t>::max()};
+      t.timestamps = {0, std::numeric_limits<int64_t>::max(), std::numeric_limits<int64_t>::min(), -1, 1, 0};
+      t.states = {std::numeric_limits<int16_t>::min(), std::numeric_limits<int16_t>::min(), 0,
+                  std::numeric_limits<int16_t>::max()};
+      
+      std::vector<std::byte> s{};
+      glz::write_binary(t, s);
+      telemetry t2{};
+      t2.counts = {5, 5};
+      glz::read_binary(t2, s);
+      expect(t2.counts == t.counts);
+      expect(t2.timestamps == t.timestamps);
+      expect(t2.states == t.states);
+      expect(t2.raw.empty());
+   };
+   
+   "truncated compact encodings"_test = [] {
+      telemetry t{};
+      t.counts.assign(1000, 300); // two bytes each
+      t.states.assign(1000, 7);
+      std::string s{};
+      glz::write_binary(t, s);
+      
+      // cut inside the counts, so that fewer values remain than the header claims
+      for (const size_t keep : {size_t(1000), size_t(20)}) {
+         const std::string cut = s.substr(0, keep);
+         telemetry t2{};
+         expect(throws([&] { glz::read_binary(t2, cut); }));
+         
+         telemetry t3{};
+         static constexpr glz::opts quiet{.format = glz::binary, .no_except = true};
+         glz::read<quiet>(t3, cut);
+         expect(t3.counts.size() < t.counts.size() || t3.states.size() < t.states.size());
+      }
+
+   };
+   
+   "compact encodings with binary_view"_test = [] {
+      static constexpr glz::opts table{.format = glz::binary, .offset_table = true};
+      telemetry t{};
+      t.timestamps = {100, 200, 300};
+      std::vector<std::byte> s{};
+      glz::write<table>(t, s);
+      
+      glz::binary_view<telemetry> view{s};
+      expect(view.get<int64_t>("/timestamps/2") == 300);
+      expect(view.get<std::vector<int64_t>>("/timestamps") == t.timestamps);
+   };
+   
+   "varint decode throughput"_test = [] {
+      telemetry t{};
+      t.counts.resize(1 << 20);
+      for (size_t i = 0; i < t.counts.size(); ++i) {
+         t.counts[i] = static_cast<uint32_t>((i * 2654435761u) >> (i % 4 == 0 ? 12 : 26));
+      }
+      std::string s{};
+      glz::write_binary(t, s);
+      
+      telemetry t2{};
+      const auto tstart = std::chrono::high_resolution_clock::now();
+      for (size_t i = 0; i < 20; ++i) {
+         glz::read_binary(t2, s);
+      }
+      const auto tend = std::chrono::high_resolution_clock::now();
+      const auto duration = std::chrono::duration_cast<std::chrono::duration<double>>(tend - tstart).count();
+      std::cout << "varint decode: " << s.size() << " bytes, "
+                << 20 * t.counts.size() / (duration * 1e6) << " M integers/s\n";
+      expect(t2.counts == t.counts);
+   };
+}
+
+struct endian_sample
+{
+   uint32_t id{0x01020304};
+   std::u16string name{u"sensor"};
+   std::vector<double> values{1.5, -2.25, 1e300};
+   std::array<int16_t, 3> offsets{-1, 256, 7};
+   std::map<std::string, uint64_t> counters{{"a", 1}, {"b", 0x0102030405060708}};
+   Color color{Color::Blue};
+};
+
+template <>
+struct glz::meta<endian_sample>
+{
+   using T = endian_sample;
+   static constexpr auto value = object("id", &T::id, "name", &T::name, "values", &T::values, "offsets",
+                                        &T::offsets, "counters", &T::counters, "color", &T::color);
+};
+
+void endianness_tests()
+{
+   using namespace boost::ut;
+   
+   "byteswap"_test = [] {
+      expect(glz::detail::byteswap(uint16_t{0x0102}) == 0x0201);
+      expect(glz::detail::byteswap(uint32_t{0x01020304}) == 0x04030201);
+      expect(glz::detail::byteswap(uint64_t{0x0102030405060708}) == 0x0807060504030201);
+      expect(glz::detail::byteswap_value(glz::detail::byteswap_value(-2.25)) == -2.25);
+      
+      std::vector<uint32_t> v{0x01020304, 0xaabbccdd, 0};
+      glz::detail::byteswap_array(v.data(), v.size());
+      expect(v == std::vector<uint32_t>{0x04030201, 0xddccbbaa, 0});
+   };
+   
+   "little endian wire format"_test = [] {
+      static constexpr glz::opts le{.format = glz::binary, .little_endian = true};
+      
+      std::vector<std::byte> s{};
+      glz::write<le>(uint32_t{0x01020304}, s);
+      expect(s == std::vector<std::byte>{std::byte{4}, std::byte{3}, std::byte{2}, std::byte{1}});
+      
+      // headers are (size << 2) | config, little endian
+      s.clear();
+      glz::write<le>(std::string{"hello"}, s);
+      expect(s.size() == 6);
+      expect(s[0] == std::byte{5 << 2});
+      
+      s.clear();
+      glz::write<le>(std::string(300, 'x'), s);
+      expect(s[0] == std::byte{((300 << 2) | 1) & 0xff});
+      expect(s[1] == std::byte{((300 << 2) | 1) >> 8});
+   };
+   
+   "little endian round trip"_test = [] {
+      static constexpr glz::opts le{.format = glz::binary, .little_endian = true};
+      static constexpr glz::opts le_table{.format = glz::binary, .offset_table = true, .little_endian = true};
+      static constexpr glz::opts le_sized{.format = glz::binary, .length_prefixed = true, .little_endian = true};
+      
+      endian_sample obj{};
+      obj.values.resize(100, 3.0);
+      
+      auto round_trip = [&](auto opts_v) {
+         static constexpr glz::opts O = decltype(opts_v)::value;
+         std::vector<std::byte> s{};
+         glz::write<O>(obj, s);
+         endian_sample obj2{};
+         obj2.id = 0;
+         obj2.name.clear();
+         obj2.values.clear();
+         obj2.offsets = {};
+         obj2.counters.clear();
+         obj2.color = Color::Red;
+         glz::read<O>(obj2, s);
+         expect(obj2.id == obj.id);
+         expect(obj2.name == obj.name);
+         expect(obj2.values == obj.values);
+         expect(obj2.offsets == obj.offsets);
+         expect(obj2.counters == obj.counters);
+         expect(obj2.color == obj.color);
+      };
+      round_trip(std::integral_constant<glz::opts, le>{});
+      round_trip(std::integral_constant<glz::opts, le_table>{});
+      round_trip(std::integral_constant<glz::opts, le_sized>{});
+      
+      std::vector<std::byte> s{};
+      glz::write<le_table>(obj, s);
+      glz::binary_view<endian_sample, le_table> view{s};
+      expect(view.get<uint64_t>("/counters/b") == 0x0102030405060708);
+      expect(view.get<double>("/values/1") == -2.25);
+   };
+}
+
+void partial_read_tests()
+{
+   using namespace boost::ut;
+   
+   static constexpr auto partial = glz::json_ptrs("/i", "/hello", "/sub/y", "/map/fish");
+   
+   "partial read"_test = [] {
+      some_struct s{};
+      s.i = 42;
+      s.hello = "updated";
+      s.sub.y = -1.0;
+      s.map["fish"] = 9;
+      std::vector<std::byte> out{};
+      glz::write_binary<partial>(s, out);
+      
+      some_struct s2{};
+      s2.d = 1.0;
+      s2.sub.x = 7.0;
+      glz::read_binary<partial>(s2, out);
+      expect(s2.i == 42);
+      expect(s2.hello == "updated");
+      expect(s2.sub.y == -1.0);
+      expect(s2.map.at("fish") == 9);
+      // members outside the partial are untouched
+      expect(s2.d == 1.0);
+      expect(s2.sub.x == 7.0);
+   };
+   
+   "partial read with options"_test = [] {
+      static constexpr glz::opts sized{.format = glz::binary, .length_prefixed = true, .little_endian = true};
+      some_struct s{};
+      s.i = 3;
+      s.map["fish"] = 4;
+      std::string out{};
+      glz::write<partial, sized>(s, out);
+      
+      some_struct s2{};
+      s2.i = 0;
+      glz::read<partial, sized>(s2, out);
+      expect(s2.i == 3);
+      expect(s2.map.at("fish") == 4);
+   };
+   
+   "partial read mismatch"_test = [] {
+      static constexpr auto other = glz::json_ptrs("/i", "/d");
+      some_struct s{};
+      s.map["fish"] = 1;
+      std::vector<std::byte> out{};
+      glz::write_binary<partial>(s, out);
+      expect(throws([&] { glz::read_binary<other>(s, out); }));
+   };
+   
+   "partial read mismatch no_except"_test = [] {
+      static constexpr auto other = glz::json_ptrs("/i", "/d");
+      static constexpr glz::opts no_except{.format = glz::binary, .no_except = true};
+      some_struct s{};
+      s.i = 5;
+      s.hello = "truncated";
+      s.map["fish"] = 1;
+      std::vector<std::byte> out{};
+      glz::write_binary<partial>(s, out);
+      
+      some_struct s2{};
+      s2.i = 0;
+      static_assert(noexcept(glz::read<other, no_except>(s2, out)));
+      glz::read<other, no_except>(s2, out);
+      expect(s2.i == 0);
+      
+      // a cut message fills the members it holds and leaves the rest
+      out.resize(out.size() / 2);
+      glz::read<partial, no_except>(s2, out);
+      expect(s2.i == 5);
+      expect(s2.map.empty());
+      
+      glz::read<partial, no_except>(s2, std::vector<std::byte>{});
+   };
+}
+
+void serialized_size_tests()
+{
+   using namespace boost::ut;
+   
+   "fixed binary size"_test = [] {
+      static_assert(glz::fixed_binary_size_v<V3> == 24);
+      static_assert(glz::fixed_binary_size_v<sub_t> == 1 + 2 * (4 + 8));
+      static_assert(glz::fixed_binary_size_v<std::array<V3, 2>> == 48);
+      expect(glz::serialized_size<glz::opts{.format = glz::binary}>(V3{}) == 24);
+      expect(glz::serialized_size<glz::opts{.format = glz::binary}>(sub_t{}) == 25);
+   };
+   
+   "serialized size"_test = [] {
+      auto check = [](auto opts_v, auto&& value) {
+         static constexpr glz::opts O = decltype(opts_v)::value;
+         std::string s{};
+         glz::write<O>(value, s);
+         expect(glz::serialized_size<O>(value) == s.size());
+         
+         static constexpr glz::opts presized = [] {
+            auto ret = O;
+            ret.presize = true;
+            return ret;
+         }();
+         std::string p{};
+         glz::write<presized>(value, p);
+         expect(p == s);
+      };
+      
+      Thing thing{};
+      endian_sample sample{};
+      telemetry t{};
+      for (uint32_t i = 0; i < 500; ++i) {
+         t.counts.emplace_back(i * i);
+         t.timestamps.emplace_back(1'600'000'000'000 + 10 * int64_t(i));
+         t.states.emplace_back(static_cast<int16_t>(i / 100));
+      }
+      auto check_all = [&](auto opts_v) {
+         check(opts_v, thing);
+         check(opts_v, sample);
+         check(opts_v, t);
+         check(opts_v, some_struct{});
+      };
+      check_all(std::integral_constant<glz::opts, glz::opts{.format = glz::binary}>{});
+      check_all(std::integral_constant<glz::opts, glz::opts{.format = glz::binary, .trusted_layout = true}>{});
+      check_all(std::integral_constant<glz::opts, glz::opts{.format = glz::binary, .length_prefixed = true}>{});
+      check_all(std::integral_constant<glz::opts, glz::opts{.format = glz::binary, .aligned_arrays = true}>{});
+      check_all(std::integral_constant<glz::opts, glz::opts{.format = glz::binary, .offset_table = true}>{});
+      
+      // a member larger than 2^14 bytes needs a four byte length header
+      std::vector<double> big(3000, 1.0);
+      my_struct_v2 v2{};
+      check(std::integral_constant<glz::opts, glz::opts{.format = glz::binary, .length_prefixed = true}>{}, big);
+      check(std::integral_constant<glz::opts, glz::opts{.format = glz::binary, .length_prefixed = true}>{}, v2);
+   };
+   
+   "presized write allocates once"_test = [] {
+      std::vector<std::vector<double>> v(100, std::vector<double>(1000, 2.0));
+      std::vector<std::byte> s{};
+      glz::write<glz::opts{.format = glz::binary, .presize = true}>(v, s);
+      expect(s.capacity() == s.size());
+      
+      std::vector<std::vector<double>> v2{};
+      glz::read_binary(v2, s);
+      expect(v2 == v);
+   };
+}
+
+void binary_log_tests()
+{
+   using namespace boost::ut;
+   
+   "crc32"_test = [] {
+      const std::string_view check = "123456789";
+      expect(glz::crc32(check.data(), check.size()) == 0xCBF43926);
+      expect(glz::crc32(check.data() + 4, 5, glz::crc32(check.data(), 4)) == 0xCBF43926);
+      expect(glz::crc32(nullptr, 0) == 0);
+   };
+   
+   // a log of n records, record i holds sub_t{i, -i} at time 10 i
+   auto write_test_log = [](const std::string& path, const size_t n) {
+      glz::binary_log_writer log{path, 64};
+      for (size_t i = 0; i < n; ++i) {
+         log.write(sub_t{double(i), -double(i)}, int64_t(i) * 10);
+      }
+      expect(log.size() == n);
+      expect(throws([&] { log.write(sub_t{}, 0); }));
+   };
+   
+   "binary log"_test = [&] {
+      const std::string path = "binary_log_test.glz";
+      constexpr size_t n = 10000;
+      write_test_log(path, n);
+      
+      {
+         glz::binary_log_reader log{path};
+         expect(!log.recovered());
+         expect(log.size() == n);
+         expect(log.read<sub_t>(0).x == 0.0);
+         expect(log.read<sub_t>(5000).y == -5000.0);
+         expect(log.read<sub_t>(n - 1).x == double(n - 1));
+         expect(log.time(777) == 7770);
+         expect(throws([&] { log.record(n); }));
+         
+         expect(log.seek_time(50000) == 5000);
+         expect(log.seek_time(50005) == 5001);
+         expect(log.seek_time(-1) == 0);
+         expect(log.seek_time(int64_t(n) * 10) == n);
+         
+         size_t count = 0;
+         double sum = 0.0;
+         log.replay(log.seek_time(1000), log.seek_time(2000), [&](const std::string_view payload, const int64_t) {
+            sub_t value{};
+            glz::binary_log_reader<>::decode(value, payload);
+            sum += value.x;
+            ++count;
+         });
+         expect(count == 100);
+         expect(sum == (100.0 + 199.0) * 50.0);
+      }
+      std::filesystem::remove(path);
+   };
+   
+   "binary log recovery"_test = [&] {
+      const std::string path = "binary_log_recovery.glz";
+      write_test_log(path, 10000);
+      std::string whole{};
+      glz::file_to_buffer(whole, path);
+      
+      // a log cut off halfway through a record, as left by a writer that did not close
+      const auto cut = whole.size() / 2;
+      {
+         std::ofstream out{path, std::ios::binary | std::ios::trunc};
+         out.write(whole.data(), cut);
+      }
+      {
+         glz::binary_log_reader log{path};
+         expect(log.recovered());
+         expect(log.size() > 0 && log.size() < 10000);
+         expect(log.read<sub_t>(log.size() - 1).x == double(log.size() - 1));
+         expect(log.seek_time(100) == 10);
+      }
+      
+      // a flipped payload byte fails the CRC
+      whole[whole.size() / 3] ^= 0x55;
+      {
+         std::ofstream out{path, std::ios::binary | std::ios::trunc};
+         out.write(whole.data(), whole.size());
+      }
+      {
+         glz::binary_log_reader log{path};
+         bool corrupt = false;
+         for (size_t i = 0; i < log.size(); ++i) {
+            try {
+               log.record(i);
+            }
+            catch (const std::exception&) {
+               corrupt = true;
+            }
+         }
+         expect(corrupt);
+      }
+      std::filesystem::remove(path);
+   };
+   
+   "binary log corrupt sizes"_test = [&] {
+      const std::string path = "binary_log_sizes.glz";
+      write_test_log(path, 10);
+      std::string whole{};
+      glz::file_to_buffer(whole, path);
+      auto rewrite = [&](const std::string& bytes) {
+         std::ofstream out{path, std::ios::binary | std::ios::trunc};
+         out.write(bytes.data(), bytes.size());
+      };
+      
+      // the size of record 1 runs past the file, records behind it cannot be located
+      uint32_t size0{};
+      std::memcpy(&size0, whole.data() + 8, sizeof(size0));
+      std::string bad = whole;
+      std::memset(bad.data() + 8 + 16 + size0, 0xff, 4);
+      rewrite(bad);
+      {
+         glz::binary_log_reader log{path};
+         expect(!log.recovered());
+         expect(log.read<sub_t>(0).x == 0.0);
+         expect(throws([&] { log.read<sub_t>(3); }));
+         expect(throws([&] { log.seek_time(50); }));
+         expect(throws([&] { log.replay(0, 10, [](const std::string_view, const int64_t) {}); }));
+      }
+      
+      // a record count the index cannot cover, the index is rebuilt from the records
+      bad = whole;
+      const uint64_t records = 1'000'000;
+      std::memcpy(bad.data() + bad.size() - 40 + 16, &records, sizeof(records));
+      rewrite(bad);
+      {
+         glz::binary_log_reader log{path};
+         expect(log.recovered());
+         expect(log.size() == 10);
+         expect(log.read<sub_t>(9).x == 9.0);
+      }
+      std::filesystem::remove(path);
+   };
+   
+   "binary log throughput"_test = [] {
+      const std::string path = "binary_log_bench.glz";
+      constexpr size_t n = 1'000'000;
+      auto t0 = std::chrono::steady_clock::now();
+      {
+         glz::binary_log_writer log{path};
+         for (size_t i = 0; i < n; ++i) {
+            log.write(sub_t{double(i), 1.0}, int64_t(i));
+         }
+      }
+      auto t1 = std::chrono::steady_clock::now();
+      glz::binary_log_reader log{path};
+      sub_t value{};
+      double sum{};
+      for (size_t i = 0; i < 100000; ++i) {
+         log.read(value, (i * 7919) % n);
+         sum += value.y;
+      }
+      auto t2 = std::chrono::steady_clock::now();
+      const auto write_s = std::chrono::duration<double>(t1 - t0).count();
+      const auto seek_s = std::chrono::duration<double>(t2 - t1).count();
+      std::cout << "binary log: " << n / (write_s * 1e6) << " M records/s written, " << 100000 / (seek_s * 1e6)
+                << " M random reads/s\n";
+      expect(sum == 100000.0);
+      std::filesystem::remove(path);
+   };
+}
+
+struct sensor_series
+{
+   std::vector<int64_t> times{};
+   std::vector<double> values{};
+};
+
+template <>
+struct glz::meta<sensor_series>
+{
+   using T = sensor_series;
+   static constexpr auto value = object("times", glz::gorilla<&T::times>, "values", glz::gorilla<&T::values>);
+};
+
+struct sensor_channel
+{
+   glz::compressed<int64_t> times{};
+   glz::compressed<double> values{};
+};
+
+template <>
+struct glz::meta<sensor_channel>
+{
+   using T = sensor_channel;
+   static constexpr auto value = object("times", &T::times, "values", &T::values);
+};
+
+void gorilla_tests()
+{
+   using namespace boost::ut;
+   
+   "gorilla doubles"_test = [] {
+      const std::vector<double> input{0.0, -0.0, 1.5, 1.5, 1.75, std::numeric_limits<double>::quiet_NaN(),
+         std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity(),
+         std::numeric_limits<double>::denorm_min(), std::numeric_limits<double>::max(), -1e-300, 3.0, 3.0, 3.0};
+      glz::compressed<double> c{};
+      for (auto x : input) {
+         c.push_back(x);
+      }
+      expect(c.size() == input.size());
+      expect(c.back() == 3.0);
+      
+      size_t i = 0;
+      for (const double x : c) {
+         expect(std::bit_cast<uint64_t>(x) == std::bit_cast<uint64_t>(input[i]));
+         ++i;
+      }
+      expect(i == input.size());
+   };
+   
+   "gorilla integers"_test = [] {
+      std::vector<int64_t> input{0, 1, 2, 3, 5, 8, 13, 1000, 1001, -5000000,
+         std::numeric_limits<int64_t>::max(), std::numeric_limits<int64_t>::min(), 0, 7};
+      for (int64_t t = 1'600'000'000'000; t < 1'600'000'010'000; t += 10 + t % 3) {
+         input.emplace_back(t);
+      }
+      glz::compressed<int64_t> c{};
+      for (auto x : input) {
+         c.push_back(x);
+      }
+      expect(std::equal(c.begin(), c.end(), input.begin(), input.end()));
+      
+      glz::compressed<uint8_t> bytes{};
+      for (int k = 0; k < 600; ++k) {
+         bytes.push_back(static_cast<uint8_t>(k * 37));
+      }
+      size_t k = 0;
+      for (const auto x : bytes) {
+         expect(x == static_cast<uint8_t>(k * 37));
+         ++k;
+      }
+      
+      glz::compressed<float> floats{};
+      for (int j = 0; j < 100; ++j) {
+         floats.push_back(j * 0.25f);
+      }
+      expect(*std::next(floats.begin(), 10) == 2.5f);
+   };
+   
+   "gorilla binary round trip"_test = [] {
+      glz::compressed<double> c{};
+      for (int i = 0; i < 1000; ++i) {
+         c.push_back(20.0 + (i / 50) * 0.125);
+      }
+      std::string s{};
+      glz::write_binary(c, s);
+      expect(s.size() < 1000);
+      expect(s.size() == glz::serialized_size<glz::opts{.format = glz::binary}>(c));
+      
+      glz::compressed<double> c2{};
+      glz::read_binary(c2, s);
+      expect(c2.size() == c.size());
+      expect(std::equal(c.begin(), c.end(), c2.begin(), c2.end()));
+      
+      // a restored stream continues where it left off
+      c.push_back(-1.0);
+      c2.push_back(-1.0);
+      expect(c2.words() == c.words());
+      expect(c2.back() == -1.0);
+      
+      std::vector<std::byte> le{};
+      glz::write<glz::opts{.format = glz::binary, .little_endian = true}>(c, le);
+      glz::compressed<double> c3{};
+      glz::read<glz::opts{.format = glz::binary, .little_endian = true}>(c3, le);
+      expect(std::equal(c.begin(), c.end(), c3.begin(), c3.end()));
+   };
+   
+   "gorilla encoding"_test = [] {
+      sensor_series series{};
+      for (int i = 0; i < 10000; ++i) {
+         series.times.emplace_back(1'600'000'000'000 + 100 * int64_t(i));
+         series.values.emplace_back(std::round(std::sin(i * 0.001) * 1000.0) / 8.0);
+      }
+      std::string s{};
+      glz::write_binary(series, s);
+      expect(s.size() == glz::serialized_size<glz::opts{.format = glz::binary}>(series));
+      const auto raw = series.times.size() * 16;
+      std::cout << "gorilla: " << raw << " raw bytes to " << s.size() << " bytes\n";
+      expect(s.size() < raw / 4);
+      
+      sensor_series series2{};
+      glz::read_binary(series2, s);
+      expect(series2.times == series.times);
+      expect(series2.values == series.values);
+      
+      // a compressed channel has the same wire format as a gorilla encoded vector
+      sensor_channel channel{};
+      glz::read_binary(channel, s);
+      expect(std::equal(channel.times.begin(), channel.times.end(), series.times.begin(), series.times.end()));
+      expect(std::equal(channel.values.begin(), channel.values.end(), series.values.begin(), series.values.end()));
+   };
+   
+   "truncated gorilla stream"_test = [] {
+      // the bit count runs past the input
+      sensor_series series{};
+      series.values.assign(100, 1.5);
+      std::string s{};
+      glz::write_binary(series, s);
+      sensor_series series2{};
+      expect(throws([&] { glz::read_binary(series2, s.substr(0, s.size() - 4)); }));
+   };
+   
+   "corrupt gorilla stream"_test = [] {
+      // a count that the bits cannot hold, the stream is one word with a single value
+      glz::compressed<double> c{};
+      c.push_back(1.5);
+      std::string stream{};
+      glz::write_binary(c, stream);
+      std::string bad = stream;
+      bad[0] = char(63 << 2);
+      glz::compressed<double> c2{};
+      expect(throws([&] { glz::read_binary(c2, bad); }));
+      expect(c2.empty());
+      
+      sensor_series series{};
+      series.values = {1.5};
+      std::string s{};
+      glz::write_binary(series, s);
+      const auto at = s.find(stream);
+      expect(at != std::string::npos);
+      s[at] = char(63 << 2);
+      sensor_series series2{};
+      expect(throws([&] { glz::read_binary(series2, s); }));
+      expect(series2.values.empty());
+      static constexpr glz::opts no_except{.format = glz::binary, .no_except = true};
+      glz::read<no_except>(series2, s);
+      expect(series2.values.empty());
+      
+      // a window of 31 leading and 64 meaningful bits does not fit a double
+      c.push_back(3.0);
+      auto words = c.words();
+      words[1] |= ~uint64_t{} << 51;
+      expect(!c2.assign(words, c.bit_size(), 2));
+      expect(c2.empty());
+      expect(c2.assign(c.words(), c.bit_size(), 2));
+      expect(c2.back() == 3.0);
+   };
+   
+   "compressed recorder"_test = [] {
+      glz::recorder<glz::compressed<double>, glz::compressed<int64_t>, float> rec;
+      glz::recorder<double, int64_t, float> plain;
+      
+      double temperature = 20.0;
+      int64_t time = 0;
+      float load = 0.f;
+      rec["temperature"] = temperature;
+      rec["time"] = time;
+      rec["load"] = load;
+      plain["temperature"] = temperature;
+      plain["time"] = time;
+      plain["load"] = load;
+      
+      constexpr size_t n = 100000;
+      const auto t0 = std::chrono::steady_clock::now();
+      for (size_t i = 0; i < n; ++i) {
+         temperature = 20.0 + double(i / 100 % 40) * 0.25;
+         time += 1000;
+         load = float(i % 10);
+         rec.update();
+      }
+      const auto t1 = std::chrono::steady_clock::now();
+      for (size_t i = 0; i < n; ++i) {
+         plain.update();
+      }
+      
+      expect(std::get<glz::compressed<double>>(rec.data[0].second.first).size() == n);
+      expect(std::get<glz::compressed<int64_t>>(rec.data[1].second.first).back() == int64_t(n) * 1000);
+      expect(std::holds_alternative<glz::chunked<float>>(rec.data[2].second.first));
+      
+      std::string s{};
+      glz::write_binary(rec, s);
+      std::string full{};
+      glz::write_binary(plain, full);
+      const auto seconds = std::chrono::duration<double>(t1 - t0).count();
+      std::cout << "compressed recorder: " << full.size() << " bytes to " << s.size() << " bytes, "
+                << n / (seconds * 1e6) << " M updates/s\n";
+      expect(s.size() < full.size() / 2);
+      
+      glz::recorder<glz::compressed<double>, glz::compressed<int64_t>, float> rec2;
+      glz::read_binary(rec2, s);
+      expect(rec2.data.size() == 3);
+      const auto& temps = std::get<glz::compressed<double>>(rec2.data[0].second.first);
+      const auto& original = std::get<glz::compressed<double>>(rec.data[0].second.first);
+      expect(std::equal(temps.begin(), temps.end(), original.begin(), original.end()));
+      expect(std::get<glz::chunked<float>>(rec2.data[2].second.first).size() == n);
+      rec2.update(); // channels read without a source are not updated
+      
+      glz::recorder<double, float> other;
+      other.data.emplace_back("temperature", std::make_pair(glz::recorder<double, float>::container_type{glz::chunked<double>{}}, nullptr));
+      expect(throws([&] { glz::read_binary(other, s); }));
+   };
+   
+   "ring recorder"_test = [] {
+      glz::recorder<glz::ring<double>, glz::ring<int64_t>> rec;
+      rec.ring_capacity = 1000;
+      double x = 0.0;
+      int64_t t = 0;
+      rec["x"] = x;
+      rec["t"] = t;
+      
+      constexpr size_t n = 25'500;
+      for (size_t i = 0; i < n; ++i) {
+         x = double(i) * 0.5;
+         t = int64_t(i);
+         rec.update();
+      }
+      const auto& window = std::get<glz::ring<int64_t>>(rec.data[1].second.first);
+      expect(window.size() == 1000);
+      expect(window.capacity() == 1000);
+      expect(window.front() == int64_t(n - 1000));
+      expect(window.back() == int64_t(n - 1));
+      
+      // the snapshot holds the current window and reads into a plain recorder as well as a ring recorder
+      std::string s{};
+      glz::write_binary(rec, s);
+      
+      glz::recorder<double, int64_t> plain;
+      glz::read_binary(plain, s);
+      const auto& times = std::get<glz::chunked<int64_t>>(plain.data[1].second.first);
+      expect(times.size() == 1000);
+      expect(std::equal(times.begin(), times.end(), window.begin(), window.end()));
+      
+      glz::recorder<glz::ring<double>, glz::ring<int64_t>> rec2;
+      glz::read_binary(rec2, s);
+      expect(std::get<glz::ring<double>>(rec2.data[0].second.first) ==
+             std::get<glz::ring<double>>(rec.data[0].second.first));
+      
+      glz::recorder<glz::ring<double>> unset;
+      expect(throws([&] { unset["x"] = x; }));
+   };
+   
+   "mixed ring recorder round trip"_test = [] {
+      // plain and ring channels of the same type share a wire format
+      using recorder_t = glz::recorder<double, glz::ring<double>>;
+      recorder_t rec;
+      double x = 0.0;
+      double y = 0.0;
+      rec["x"] = x;
+      rec.data.emplace_back("y", std::make_pair(recorder_t::container_type{glz::ring<double>{4}}, &y));
+      ++rec.generation;
+      for (size_t i = 0; i < 10; ++i) {
+         x = double(i);
+         y = -double(i);
+         rec.update();
+      }
+      std::string s{};
+      glz::write_binary(rec, s);
+      
+      // registered channels keep their storage
+      recorder_t same;
+      double x2{}, y2{};
+      same["x"] = x2;
+      same.data.emplace_back("y", std::make_pair(recorder_t::container_type{glz::ring<double>{4}}, &y2));
+      ++same.generation;
+      glz::read_binary(same, s);
+      expect(std::get<glz::chunked<double>>(same.data[0].second.first).size() == 10);
+      const auto& window = std::get<glz::ring<double>>(same.data[1].second.first);
+      expect(std::vector<double>(window.begin(), window.end()) == std::vector<double>{-6.0, -7.0, -8.0, -9.0});
+      
+      glz::read_binary(rec, s);
+      expect(std::get<glz::chunked<double>>(rec.data[0].second.first).size() == 10);
+      expect(std::get<glz::ring<double>>(rec.data[1].second.first).size() == 4);
+      
+      // new channels take plain storage
+      recorder_t fresh;
+      glz::read_binary(fresh, s);
+      expect(std::get<glz::chunked<double>>(fresh.data[0].second.first).size() == 10);
+      expect(std::get<glz::chunked<double>>(fresh.data[1].second.first).size() == 4);
+   };
+   
+   "mapped column recorder"_test = [] {
+      glz::recorder<glz::mapped_column<double>, float> rec;
+      rec.column_directory = ".";
+      double x = 0.0;
+      float y = 0.f;
+      rec["binary_spill_x"] = x;
+      rec["y"] = y;
+      for (size_t i = 0; i < 10000; ++i) {
+         x = double(i) * 0.5;
+         y = float(i);
+         rec.update();
+      }
+      
+      // mapped columns are contiguous, so they are written like vectors and read into plain recorders
+      std::string s{};
+      glz::write_binary(rec, s);
+      glz::recorder<double, float> plain;
+      glz::read_binary(plain, s);
+      const auto& xs = std::get<glz::chunked<double>>(plain.data[0].second.first);
+      const auto& original = std::get<glz::mapped_column<double>>(rec.data[0].second.first);
+      expect(std::equal(xs.begin(), xs.end(), original.begin(), original.end()));
+   };
+}
+
 int main()
 {
    using namespace boost::ut;
 
    write_tests();
+   parallel_write_tests();
+   trusted_layout_tests();
+   length_prefixed_tests();
+   view_tests();
+   offset_table_tests();
+   compact_encoding_tests();
+   endianness_tests();
    bench();
    test_partial();
+   partial_read_tests();
+   serialized_size_tests();
+   binary_log_tests();
+   gorilla_tests();
    file_include_test();
 }
@@ -2,19 +2,30 @@
 // Developed by Anyar Inc.
 
 #include "glaze/csv.hpp"
+#include "glaze/file/file_ops.hpp"
 #include "glaze/record/recorder.hpp"
+#include "glaze/record/concurrent_recorder.hpp"
 
 #define BOOST_UT_DISABLE_MODULE 1
 
 #include "boost/ut.hpp"
 
 
+#include <array>
+#include <chrono>
 #include <cmath>
 #include <deque>
+#include <fstream>
 #include <iostream>
 #include <functional>
 #include <numeric>
 #include <sstream>
+#include <thread>
+
+#ifndef _WIN32
+#include <csignal>
+#include <sys/resource.h>
+#endif
 
 using namespace boost::ut;
 using namespace glz;
@@ -129,6 +140,10 @@ suite csv_read = [] {
         std::deque<bool> z;
 
         from_csv_file("rowwise_to_file_test", x, y, z);
+        expect(x.size() == 100);
+        expect(x[99] == 99.0);
+        expect(y[3] == std::sin(3.0));
+        expect(z.size() == 100 && z[0] && !z[1]);
     };
 
     "colwise_from_file"_test = [] {
@@ -136,8 +151,183 @@ suite csv_read = [] {
         std::deque<bool> z;
 
         from_csv_file<false>("colwise_to_file_test", z, y, x);
+        expect(x.size() == 100);
+        expect(x[42] == 42.0);
+        expect(y[7] == std::sin(7.0));
+        expect(z.size() == 100 && z[98] && !z[99]);
+    };
+
+    "buffer_formats"_test = [] {
+        std::vector<int> a;
+        std::vector<float> b;
+        read_csv<false>("a,b,c\r\n1, 2.5 ,x\r\n-3,1e3\r\n\r\n4,0", std::forward_as_tuple(a, b));
+        expect(a == std::vector<int>{1, -3, 4});
+        expect(b == std::vector<float>{2.5f, 1000.f, 0.f});
+
+        std::vector<uint8_t> c;
+        read_csv("c,1,2,255,\n", std::forward_as_tuple(c));
+        expect(c == std::vector<uint8_t>{1, 2, 255});
+
+        expect(throws([] {
+           std::vector<int> v;
+           read_csv("v,1,,3\n", std::forward_as_tuple(v));
+        }));
+        expect(throws([] {
+           std::vector<uint8_t> v;
+           read_csv("v,256\n", std::forward_as_tuple(v));
+        }));
+        expect(throws([] {
+           std::vector<double> v;
+           read_csv<false>("v\n1.5abc\n", std::forward_as_tuple(v));
+        }));
     };
 
+    "quoted_fields"_test = [] {
+        // quoted delimiters, line breaks and escaped quotes
+        std::vector<std::string> name;
+        std::vector<double> value;
+        read_csv<false>("name,value\n"
+                        "plain,1\n"
+                        "\"a, b\",\"2.5\"\n"
+                        "\"two\nlines\",3\r\n"
+                        "\"say \"\"hi\"\"\", 4 \n"
+                        "\"\",5\n",
+                        std::forward_as_tuple(name, value));
+        expect(name == std::vector<std::string>{"plain", "a, b", "two\nlines", "say \"hi\"", ""});
+        expect(value == std::vector<double>{1, 2.5, 3, 4, 5});
+
+        // quoted regions that cross the 64 byte blocks of the classifier
+        std::string buffer = "s,i\n";
+        std::vector<std::string> expected;
+        for (int r = 0; r < 200; ++r) {
+           std::string text(static_cast<size_t>(r % 97), 'x');
+           for (size_t k = 0; k < text.size(); k += 7) {
+              text[k] = "\",\n"[k % 3];
+           }
+           expected.emplace_back(text);
+        }
+        std::vector<int> index(expected.size());
+        for (size_t r = 0; r < index.size(); ++r) {
+           index[r] = static_cast<int>(r);
+        }
+        std::string out;
+        write_csv<false>(out, "s", expected, "i", index);
+        expect(out.find("\"\"") != std::string::npos);
+
+        std::vector<std::string> s;
+        std::vector<int> i;
+        read_csv<false>(out, std::forward_as_tuple(s, i));
+        expect(s == expected);
+        expect(i == index);
+
+        std::vector<std::string> r;
+        std::string rowwise;
+        write_csv(rowwise, "r", expected);
+        read_csv(rowwise, std::forward_as_tuple(r));
+        expect(r == expected);
+    };
+
+    "quoted_read_throughput"_test = [] {
+        std::vector<std::string> label;
+        std::vector<double> x;
+        for (int i = 0; i < 500'000; ++i) {
+            label.emplace_back(i % 4 ? "sensor " + std::to_string(i % 100) : "a, \"quoted\" label");
+            x.emplace_back(double(i) * 0.25);
+        }
+        std::string buffer;
+        write_csv<false>(buffer, "label", label, "x", x);
+
+        std::vector<std::string> label2;
+        std::vector<double> x2;
+        const auto t0 = std::chrono::steady_clock::now();
+        read_csv<false>(buffer, std::forward_as_tuple(label2, x2));
+        const auto t1 = std::chrono::steady_clock::now();
+        const auto seconds = std::chrono::duration<double>(t1 - t0).count();
+        std::cout << "quoted csv read: " << buffer.size() / (seconds * 1e6) << " MB/s\n";
+        expect(label2 == label);
+        expect(x2 == x);
+    };
+
+    "colwise_read_throughput"_test = [] {
+        std::vector<double> x, y;
+        std::vector<int64_t> t;
+        for (int64_t i = 0; i < 1'000'000; ++i) {
+            t.emplace_back(1'600'000'000'000 + i);
+            x.emplace_back(std::sin(double(i)));
+            y.emplace_back(double(i) * 0.25);
+        }
+        std::string buffer;
+        write_csv<false>(buffer, "t", t, "x", x, "y", y);
+
+        std::vector<double> x2, y2;
+        std::vector<int64_t> t2;
+        const auto t0 = std::chrono::steady_clock::now();
+        read_csv<false>(buffer, std::forward_as_tuple(t2, x2, y2));
+        const auto t1 = std::chrono::steady_clock::now();
+        const auto seconds = std::chrono::duration<double>(t1 - t0).count();
+        std::cout << "csv read: " << buffer.size() / (seconds * 1e6) << " MB/s\n";
+        expect(t2 == t);
+        expect(x2 == x);
+        expect(y2 == y);
+    };
+
+   "parallel_colwise_read"_test = [] {
+      std::vector<double> x;
+      std::vector<int64_t> t;
+      for (int64_t i = 0; i < 2'000'000; ++i) {
+         t.emplace_back(i);
+         x.emplace_back(std::sin(double(i)));
+      }
+      std::string buffer;
+      write_csv<false>(buffer, "t", t, "x", x);
+
+      const auto hardware = std::max(std::thread::hardware_concurrency(), 1u);
+      for (unsigned threads = 1; threads <= std::max(hardware, 4u); threads *= 2) {
+         glz::pool pool{threads};
+         std::vector<double> x2;
+         std::vector<int64_t> t2;
+         const auto t0 = std::chrono::steady_clock::now();
+         read_csv<false>(buffer, std::forward_as_tuple(t2, x2), pool);
+         const auto t1 = std::chrono::steady_clock::now();
+         const auto seconds = std::chrono::duration<double>(t1 - t0).count();
+         std::cout << "parallel csv read, " << threads << " threads: " << buffer.size() / (seconds * 1e6) << " MB/s\n";
+         expect(t2 == t);
+         expect(x2 == x);
+      }
+
+      std::vector<double> rows;
+      glz::pool pool{4};
+      std::string rowwise;
+      write_csv(rowwise, "t", t, "x", x);
+      std::vector<int64_t> t3;
+      read_csv(rowwise, std::forward_as_tuple(t3, rows), pool);
+      expect(t3 == t);
+      expect(rows == x);
+   };
+
+   "parallel_chunks_respect_quotes"_test = [] {
+      // a third, quoted column holds newlines, which must not be taken as line ends
+      std::string buffer = "a,b,note\n";
+      for (int i = 0; i < 200'000; ++i) {
+         buffer += std::to_string(i) + ",0.5,";
+         buffer += (i % 3 == 0) ? "\"line\nbreak, \"\"quoted\"\"\n\"\n" : "plain\n";
+      }
+      glz::pool pool{4};
+      const auto bounds = glz::detail::csv_chunks(pool, buffer.data() + 9, buffer.data() + buffer.size(), 16);
+      expect(bounds.size() > 2);
+      for (size_t i = 1; i + 1 < bounds.size(); ++i) {
+         expect(bounds[i][-1] == '\n');
+         expect(std::count(static_cast<const char*>(buffer.data()), bounds[i], '"') % 2 == 0);
+      }
+
+      std::vector<int> a;
+      std::vector<double> b;
+      read_csv<false>(buffer, std::forward_as_tuple(a, b), pool);
+      expect(a.size() == 200'000);
+      expect(a.back() == 199'999);
+      expect(b.size() == 200'000);
+   };
+
     // more complicated. needs a small discussion on expectations
     //"from_file_to_map"_test = [] {
 
@@ -171,6 +361,108 @@ suite csv_read = [] {
 
 };
 
+struct sensor_columns
+{
+   std::vector<int64_t> time{};
+   std::vector<double> temperature{};
+   std::deque<bool> valid{};
+};
+
+template <>
+struct glz::meta<sensor_columns>
+{
+   using T = sensor_columns;
+   static constexpr auto value = object("time", &T::time, "temperature", &T::temperature, "valid", &T::valid);
+};
+
+struct sensor_row
+{
+   int64_t time{};
+   double temperature{};
+   bool valid{};
+};
+
+template <>
+struct glz::meta<sensor_row>
+{
+   using T = sensor_row;
+   static constexpr auto value = object("time", &T::time, "temperature", &T::temperature, "valid", &T::valid);
+};
+
+suite csv_struct_read = [] {
+   // the unselected columns hold values that could not be converted
+   static constexpr std::string_view columnwise = "id,time, temperature ,label,valid,extra\n"
+                                                  "a,10,20.5,x,1,?\n"
+                                                  "b,20,21.25,y,0,?\r\n"
+                                                  "\n"
+                                                  "c,30,22,z,1\n";
+
+   "struct_of_vectors"_test = [] {
+      sensor_columns s{};
+      read_csv<false>(columnwise, s);
+      expect(s.time == std::vector<int64_t>{10, 20, 30});
+      expect(s.temperature == std::vector<double>{20.5, 21.25, 22.0});
+      expect(s.valid == std::deque<bool>{true, false, true});
+   };
+
+   "vector_of_structs"_test = [] {
+      std::vector<sensor_row> rows{};
+      read_csv<false>(columnwise, rows);
+      expect(rows.size() == 3);
+      expect(rows[1].time == 20);
+      expect(rows[1].temperature == 21.25);
+      expect(!rows[1].valid && rows[2].valid);
+   };
+
+   "rowwise_struct"_test = [] {
+      sensor_columns s{};
+      read_csv("label,a,b\ntemperature,1.5,2.5,\ntime,1,2\n", s);
+      expect(s.time == std::vector<int64_t>{1, 2});
+      expect(s.temperature == std::vector<double>{1.5, 2.5});
+      expect(s.valid.empty());
+   };
+
+   "struct_from_file"_test = [] {
+      sensor_columns s{};
+      s.time = {1, 2};
+      s.temperature = {0.5, 0.25};
+      s.valid = {true, false};
+      std::string buffer;
+      write_csv<false>(buffer, "time", s.time, "temperature", s.temperature, "valid", s.valid);
+      {
+         std::ofstream file{"struct_test.csv"};
+         file << buffer;
+      }
+      std::vector<sensor_row> rows{};
+      from_csv_file<false>("struct_test", rows);
+      expect(rows.size() == 2);
+      expect(rows[0].temperature == 0.5 && rows[1].time == 2);
+   };
+
+   "projection_throughput"_test = [] {
+      // 5 of 100 columns are read
+      std::string buffer;
+      for (int c = 0; c < 100; ++c) {
+         buffer += c == 10 ? "time" : c == 40 ? "temperature" : "c" + std::to_string(c);
+         buffer += c == 99 ? "\n" : ",";
+      }
+      for (int r = 0; r < 20000; ++r) {
+         for (int c = 0; c < 100; ++c) {
+            buffer += c == 10 ? std::to_string(r) : "0.125";
+            buffer += c == 99 ? "\n" : ",";
+         }
+      }
+      sensor_columns s{};
+      const auto t0 = std::chrono::steady_clock::now();
+      read_csv<false>(buffer, s);
+      const auto t1 = std::chrono::steady_clock::now();
+      std::cout << "csv projection: " << buffer.size() / (std::chrono::duration<double>(t1 - t0).count() * 1e6)
+                << " MB/s\n";
+      expect(s.time.size() == 20000 && s.time.back() == 19999);
+      expect(s.temperature.size() == 20000);
+   };
+};
+
 suite csv_recorder = [] {
    "recorder_to_file"_test = [] {
       
@@ -191,6 +483,533 @@ suite csv_recorder = [] {
       
       write_file_csv("recorder_out.csv", rec);
    };
+   
+   "compressed_recorder"_test = [] {
+      recorder<compressed<double>, compressed<int64_t>> rec;
+      
+      double x = 0.0;
+      int64_t t = 0;
+      
+      rec["t"] = t;
+      rec["x"] = x;
+      
+      for (int i = 0; i < 3; ++i)
+      {
+         t += 10;
+         x += 0.5;
+         rec.update();
+      }
+      
+      std::string rowwise;
+      write_csv(rowwise, rec);
+      expect(rowwise == "t,10,20,30,\nx,0.5,1,1.5,\n");
+      
+      std::string columnwise;
+      write_csv<false>(columnwise, rec);
+      expect(columnwise == "t,x\n10,0.5\n20,1\n30,1.5\n");
+   };
+   
+   "columnwise_write_throughput"_test = [] {
+      recorder<double, int64_t> rec;
+      
+      double x = 0.0;
+      double y = 0.0;
+      int64_t t = 0;
+      
+      rec["x"] = x;
+      rec["y"] = y;
+      rec["t"] = t;
+      
+      // several blocks of rows, with a partial block at the end
+      constexpr size_t n = 200'003;
+      for (size_t k = 0; k < n; ++k) {
+         x = std::sin(double(k));
+         y += 0.25;
+         t += 1000;
+         rec.update();
+      }
+      
+      std::string buffer;
+      const auto t0 = std::chrono::steady_clock::now();
+      write_csv<false>(buffer, rec);
+      const auto t1 = std::chrono::steady_clock::now();
+      const auto seconds = std::chrono::duration<double>(t1 - t0).count();
+      std::cout << "column wise csv write: " << buffer.size() / (seconds * 1e9) << " GB/s\n";
+      
+      std::vector<double> x2, y2;
+      std::vector<int64_t> t2;
+      read_csv<false>(buffer, std::forward_as_tuple(x2, y2, t2));
+      expect(x2.size() == n);
+      expect(t2.size() == n);
+      expect(y2.back() == y);
+      expect(t2.back() == t);
+      
+      std::map<std::string, std::vector<double>> map{{"a", {}}, {"b", {}}};
+      for (size_t k = 0; k < 5000; ++k) {
+         map["a"].emplace_back(double(k));
+         map["b"].emplace_back(double(k) * 0.5);
+      }
+      std::string out;
+      write_csv<false>(out, map);
+      std::vector<double> a, b;
+      read_csv<false>(out, std::forward_as_tuple(a, b));
+      expect(a == map["a"]);
+      expect(b == map["b"]);
+   };
+   
+   "chunked_storage"_test = [] {
+      auto& pool = shared_block_pool();
+      {
+         chunked<double> c;
+         expect(c.empty());
+         constexpr size_t n = chunked<double>::chunk_size * 3 + 7;
+         for (size_t i = 0; i < n; ++i) {
+            c.push_back(double(i));
+         }
+         expect(c.size() == n);
+         expect(c.block_count() == 4);
+         expect(c.front() == 0.0);
+         expect(c.back() == double(n - 1));
+         expect(c[chunked<double>::chunk_size] == double(chunked<double>::chunk_size));
+         
+         size_t i = 0;
+         for (auto& x : c) {
+            expect(x == double(i++));
+         }
+         expect(std::distance(c.begin(), c.end()) == std::ptrdiff_t(n));
+         
+         auto copy = c;
+         expect(copy == c);
+         
+         c.resize(chunked<double>::chunk_size);
+         expect(c.size() == chunked<double>::chunk_size);
+         expect(c.block_count() == 1);
+         
+         const auto available = pool.available();
+         copy.clear();
+         expect(copy.empty());
+         expect(pool.available() == available + 4);
+      }
+      
+      // released blocks are reused
+      const auto available = pool.available();
+      chunked<int> c;
+      c.push_back(1);
+      expect(pool.available() == available - 1);
+   };
+   
+   "recorder_erase_channel"_test = [] {
+      recorder<double, float> rec;
+      double x = 1.0;
+      float y = 2.f;
+      double z = 3.0;
+      rec["x"] = x;
+      rec["y"] = y;
+      rec.update();
+      
+      // the same number of channels, but a different set
+      expect(rec.erase("x"));
+      expect(!rec.erase("x"));
+      rec["z"] = z;
+      rec.update();
+      rec.update();
+      
+      expect(rec.data.size() == 2);
+      expect(rec.data[0].first == "y");
+      expect(std::get<chunked<float>>(rec.data[0].second.first).size() == 3);
+      auto& zs = std::get<chunked<double>>(rec.data[1].second.first);
+      expect(zs.size() == 2 && zs.back() == 3.0);
+   };
+   
+   "recorder_large_values"_test = [] {
+      // values larger than a chunk block are kept in a deque
+      using frame = std::array<double, 128>;
+      recorder<frame, double> rec;
+      frame f{};
+      double x = 0.0;
+      rec["f"] = f;
+      rec["x"] = x;
+      for (size_t i = 0; i < 10; ++i) {
+         f[127] = double(i);
+         x = double(i);
+         rec.update();
+      }
+      const auto& frames = std::get<std::deque<frame>>(rec.data[0].second.first);
+      expect(frames.size() == 10);
+      expect(frames.back()[127] == 9.0);
+      expect(std::get<chunked<double>>(rec.data[1].second.first).size() == 10);
+   };
+   
+   "recorder_update_cost"_test = [] {
+      for (const size_t channels : {1, 10, 100, 1000}) {
+         recorder<double, float, int64_t> rec;
+         std::vector<double> d(channels);
+         std::vector<float> f(channels);
+         std::vector<int64_t> i(channels);
+         for (size_t k = 0; k < channels; ++k) {
+            const auto name = std::to_string(k);
+            // an even mix of the three types
+            switch (k % 3) {
+            case 0:
+               rec["d" + name] = d[k];
+               break;
+            case 1:
+               rec["f" + name] = f[k];
+               break;
+            default:
+               rec["i" + name] = i[k];
+            }
+         }
+         
+         const size_t updates = 2'000'000 / channels;
+         const auto t0 = std::chrono::steady_clock::now();
+         for (size_t n = 0; n < updates; ++n) {
+            d[0] += 1.0;
+            rec.update();
+         }
+         const auto t1 = std::chrono::steady_clock::now();
+         const auto ns = std::chrono::duration<double, std::nano>(t1 - t0).count();
+         std::cout << "recorder update, " << channels << " channels: " << ns / (updates * channels)
+                   << " ns/sample\n";
+         
+         auto& x = std::get<chunked<double>>(rec.data[0].second.first);
+         expect(x.size() == updates);
+         expect(x.back() == double(updates));
+      }
+   };
+   
+   "ring_recorder"_test = [] {
+      glz::ring<int> r{4};
+      for (int i = 0; i < 3; ++i) {
+         r.push_back(i);
+      }
+      expect(r.size() == 3);
+      expect(r.front() == 0 && r.back() == 2);
+      for (int i = 3; i < 10; ++i) {
+         r.push_back(i);
+      }
+      expect(r.full());
+      expect(std::vector<int>(r.begin(), r.end()) == std::vector<int>{6, 7, 8, 9});
+      expect(r[1] == 7);
+      r.resize(2);
+      expect(std::vector<int>(r.begin(), r.end()) == std::vector<int>{8, 9});
+      r.push_back(10);
+      expect(std::vector<int>(r.begin(), r.end()) == std::vector<int>{8, 9, 10});
+      
+      recorder<ring<double>, ring<float>> rec;
+      rec.ring_capacity = 500;
+      
+      double x = 0.0;
+      float y = 0.f;
+      rec["x"] = x;
+      rec["y"] = y;
+      
+      // memory is allocated once, each update overwrites the oldest sample
+      constexpr size_t n = 1'000'000;
+      const auto t0 = std::chrono::steady_clock::now();
+      for (size_t i = 0; i < n; ++i) {
+         x = double(i);
+         y = float(i % 1000);
+         rec.update();
+      }
+      const auto t1 = std::chrono::steady_clock::now();
+      std::cout << "ring recorder update: "
+                << std::chrono::duration<double, std::nano>(t1 - t0).count() / (2 * n) << " ns/sample\n";
+      expect(std::get<ring<double>>(rec.data[0].second.first).capacity() == 500);
+      
+      std::string buffer;
+      write_csv<false>(buffer, rec);
+      std::vector<double> x2;
+      std::vector<float> y2;
+      read_csv<false>(buffer, std::forward_as_tuple(x2, y2));
+      expect(x2.size() == 500);
+      expect(x2.front() == double(n - 500));
+      expect(x2.back() == double(n - 1));
+      expect(y2.back() == float((n - 1) % 1000));
+   };
+   
+   "mapped_column_recorder"_test = [] {
+      mapped_column<int> column{"mapped_column_test.col", 4096};
+      for (int i = 0; i < 5000; ++i) {
+         column.push_back(i);
+      }
+      expect(column.size() == 5000);
+      expect(column.back() == 4999);
+      column.close();
+      {
+         const mapped_file file{"mapped_column_test.col"};
+         const auto values = column_span<int>(file);
+         expect(values.size() == 5000);
+         expect(values[1234] == 1234);
+      }
+      std::remove("mapped_column_test.col");
+      
+#ifndef _WIN32
+      // a column that cannot grow, here under a file size limit, keeps the values it has
+      {
+         rlimit limit{};
+         getrlimit(RLIMIT_FSIZE, &limit);
+         const auto previous_handler = std::signal(SIGXFSZ, SIG_IGN);
+         rlimit capped = limit;
+         capped.rlim_cur = 64 * 1024;
+         setrlimit(RLIMIT_FSIZE, &capped);
+         
+         mapped_column<int> full{"mapped_column_full.col", 4096};
+         int written = 0;
+         expect(throws([&] {
+            for (; written < 100'000; ++written) {
+               full.push_back(written);
+            }
+         }));
+         setrlimit(RLIMIT_FSIZE, &limit);
+         std::signal(SIGXFSZ, previous_handler);
+         
+         expect(full.size() == size_t(written));
+         expect(full.back() == written - 1);
+         expect(std::accumulate(full.begin(), full.end(), int64_t{}) == int64_t(written) * (written - 1) / 2);
+         full.resize(full.size() / 2);
+         expect(full.back() == written / 2 - 1);
+      }
+      std::remove("mapped_column_full.col");
+#endif
+      
+      constexpr size_t n = 2'000'000;
+      double x = 0.0;
+      float y = 0.f;
+      {
+         recorder<mapped_column<double>, mapped_column<float>> rec;
+         rec.column_directory = ".";
+         rec["spill_x"] = x;
+         rec["spill_y"] = y;
+         
+         const auto t0 = std::chrono::steady_clock::now();
+         for (size_t i = 0; i < n; ++i) {
+            x = double(i);
+            y = float(i % 100);
+            rec.update();
+         }
+         const auto t1 = std::chrono::steady_clock::now();
+         std::cout << "mapped column recorder update: "
+                   << std::chrono::duration<double, std::nano>(t1 - t0).count() / (2 * n) << " ns/sample\n";
+         
+         // the columns export with the usual writers while recording
+         std::string buffer;
+         write_csv<false>(buffer, rec);
+         std::vector<double> x2;
+         std::vector<float> y2;
+         read_csv<false>(buffer, std::forward_as_tuple(x2, y2));
+         expect(x2.size() == n);
+         expect(x2.back() == double(n - 1));
+         expect(y2[250] == 50.f);
+      }
+      
+      // the recorder trims its column files when it is destroyed
+      const mapped_file file{"spill_x.col"};
+      const auto xs = column_span<double>(file);
+      expect(xs.size() == n);
+      expect(xs[12345] == 12345.0);
+      
+      recorder<mapped_column<double>> unset;
+      expect(throws([&] { unset["x"] = x; }));
+      
+      // merged channels of a concurrent recorder spill to the merged recorder's column directory
+      {
+         concurrent_recorder<mapped_column<double>> spilled{64};
+         spilled.merged.column_directory = ".";
+         auto& producer = spilled.add_producer();
+         producer["spill_merged"] = x;
+         spilled.start();
+         for (size_t tick = 0; tick < 1000; ++tick) {
+            x = double(tick);
+            producer.update(tick);
+         }
+         spilled.stop();
+         expect(std::get<mapped_column<double>>(spilled.merged.data[0].second.first).back() == 999.0);
+      }
+      {
+         const mapped_file merged_file{"spill_merged.col"};
+         expect(column_span<double>(merged_file).size() == 1000);
+      }
+      std::remove("spill_merged.col");
+   };
+   
+   "concurrent_recorder"_test = [] {
+      concurrent_recorder<double, int64_t> rec{256};
+      
+      // three sub-systems on their own threads, the last one publishes every other tick
+      constexpr size_t n = 200'000;
+      constexpr size_t threads = 3;
+      std::vector<double> x(threads);
+      std::vector<int64_t> k(threads);
+      std::vector<decltype(rec)::producer*> producers;
+      for (size_t p = 0; p < threads; ++p) {
+         auto& producer = rec.add_producer();
+         producer["x" + std::to_string(p)] = x[p];
+         producer["k" + std::to_string(p)] = k[p];
+         producers.emplace_back(&producer);
+      }
+      rec.start();
+      expect(throws([&] { rec.add_producer(); }));
+      
+      std::vector<std::thread> workers;
+      for (size_t p = 0; p < threads; ++p) {
+         workers.emplace_back([&, p] {
+            const size_t step = p == threads - 1 ? 2 : 1;
+            for (size_t tick = 0; tick < n; tick += step) {
+               x[p] = double(tick) * double(p + 1);
+               k[p] = int64_t(tick);
+               producers[p]->update(tick);
+            }
+         });
+      }
+      for (auto& w : workers) {
+         w.join();
+      }
+      rec.stop();
+      
+      expect(rec.ticks.size() == n);
+      expect(rec.merged.data.size() == 2 * threads);
+      auto& x0 = std::get<chunked<double>>(rec.merged.data[0].second.first);
+      auto& x1 = std::get<chunked<double>>(rec.merged.data[2].second.first);
+      auto& k2 = std::get<chunked<int64_t>>(rec.merged.data[5].second.first);
+      bool merged = true;
+      for (size_t i = 0; i < n; ++i) {
+         merged &= rec.ticks[i] == i;
+         merged &= x0[i] == double(i);
+         merged &= x1[i] == double(i) * 2.0;
+         // the slower producer repeats its previous tick
+         merged &= k2[i] == int64_t(i - i % 2);
+      }
+      expect(merged);
+      
+      std::string buffer;
+      write_csv<false>(buffer, rec.merged);
+      std::vector<double> a, b;
+      read_csv<false>(buffer, std::forward_as_tuple(a, b));
+      expect(a.size() == n);
+      
+      // producer side cost, with a queue large enough that the producer never waits for the collector
+      concurrent_recorder<double> large{1 << 20};
+      std::array<double, 4> values{};
+      auto& producer = large.add_producer();
+      for (size_t c = 0; c < values.size(); ++c) {
+         producer["v" + std::to_string(c)] = values[c];
+      }
+      constexpr size_t updates = 1'000'000;
+      const auto t0 = std::chrono::steady_clock::now();
+      for (size_t tick = 0; tick < updates; ++tick) {
+         values[0] = double(tick);
+         producer.update(tick);
+      }
+      const auto t1 = std::chrono::steady_clock::now();
+      std::cout << "concurrent recorder update, 4 channels: "
+                << std::chrono::duration<double, std::nano>(t1 - t0).count() / updates << " ns/update\n";
+      large.start();
+      large.stop();
+      expect(large.ticks.size() == updates);
+      expect(std::get<chunked<double>>(large.merged.data[0].second.first).back() == double(updates - 1));
+   };
+   
+   "concurrent_recorder producer lifetimes"_test = [] {
+      // a producer that finishes early does not hold back the others, even with a small queue
+      concurrent_recorder<double> rec{16};
+      double a = 0.0;
+      double b = 0.0;
+      auto& pa = rec.add_producer();
+      pa["a"] = a;
+      auto& pb = rec.add_producer();
+      pb["b"] = b;
+      rec.start();
+      
+      std::thread short_lived([&] {
+         b = 5.0;
+         pb.update(0);
+         pb.finish();
+      });
+      constexpr size_t n = 1000;
+      std::thread long_lived([&] {
+         for (size_t tick = 0; tick < n; ++tick) {
+            a = double(tick);
+            pa.update(tick);
+         }
+         pa.finish();
+      });
+      short_lived.join();
+      long_lived.join();
+      rec.stop();
+      
+      expect(rec.ticks.size() == n);
+      auto& as = std::get<chunked<double>>(rec.merged.data[0].second.first);
+      auto& bs = std::get<chunked<double>>(rec.merged.data[1].second.first);
+      expect(as.size() == n && as.back() == double(n - 1));
+      // the finished producer repeats its last value
+      expect(bs.size() == n && bs.back() == 5.0);
+   };
+   
+   "csv_sink"_test = [] {
+      recorder<double, float, int> rec;
+      
+      double x = 0.0;
+      float y = 0.f;
+      int i = 0;
+      
+      rec["x"] = x;
+      rec["y"] = y;
+      rec["i"] = i;
+      
+      {
+         // samples are retained here so that the stream can be compared with write_csv
+         csv_sink sink{rec, "recorder_stream.csv", 16, true};
+         for (; i < 100; ++i) {
+            x += 1.5;
+            y += static_cast<float>(i);
+            rec.update();
+         }
+         expect(sink.size() == 100);
+      }
+      expect(!rec.on_update);
+      
+      std::string expected;
+      write_csv<false>(expected, rec);
+      std::string streamed;
+      glz::file_to_buffer(streamed, "recorder_stream.csv");
+      expect(streamed == expected);
+   };
+   
+   "csv_sink_throughput"_test = [] {
+      recorder<double, int64_t> rec;
+      
+      double x = 0.0;
+      double y = 0.0;
+      int64_t t = 0;
+      
+      rec["x"] = x;
+      rec["y"] = y;
+      rec["t"] = t;
+      
+      constexpr size_t n = 1'000'000;
+      csv_sink sink{rec, "recorder_stream_bench.csv"};
+      const auto t0 = std::chrono::steady_clock::now();
+      for (size_t k = 0; k < n; ++k) {
+         x = std::sin(double(k));
+         y += 0.25;
+         t += 1000;
+         rec.update();
+      }
+      sink.close();
+      const auto t1 = std::chrono::steady_clock::now();
+      const auto seconds = std::chrono::duration<double>(t1 - t0).count();
+      std::cout << "csv sink: " << n / (seconds * 1e6) << " M rows/s\n";
+      
+      // nothing is kept in memory while streaming
+      expect(variant_container_size(rec.data[0].second.first) == 0);
+      
+      std::vector<double> x2, y2;
+      std::vector<int64_t> t2;
+      from_csv_file<false>("recorder_stream_bench", x2, y2, t2);
+      expect(x2.size() == n);
+      expect(t2.back() == int64_t(n) * 1000);
+   };
 };
 
 int main()
@@ -10,6 +10,7 @@
 #include <map>
 #include <list>
 #include <deque>
+#include <numeric>
 
 #include "glaze/core/macros.hpp"
 #include "boost/ut.hpp"
@@ -205,6 +206,58 @@ struct glz::meta<Escaped> {
                                         R"(escape_chars)", &T::escape_chars);
 };
 
+suite prettify_minify_tests = [] {
+   "prettify"_test = [] {
+      std::string buffer = R"({"a":[],"b":"x\"y,{z}: \\","c":{"d":[1,2.5e3],"e":null}})";
+      expect(glz::prettify(buffer) == R"({
+   "a": [],
+   "b": "x\"y,{z}: \\",
+   "c": {
+      "d": [
+         1,
+         2.5e3
+      ],
+      "e": null
+   }
+})");
+      
+      expect(glz::prettify(buffer, true) == "{\n\t\"a\": [],\n\t\"b\": \"x\\\"y,{z}: \\\\\",\n\t\"c\": "
+             "{\n\t\t\"d\": [\n\t\t\t1,\n\t\t\t2.5e3\n\t\t],\n\t\t\"e\": null\n\t}\n}");
+   };
+   
+   "prettify comments"_test = [] {
+      std::string buffer = R"({"i":1/*one*/,"j":2 // two
+// three
+})";
+      expect(glz::prettify(buffer) == R"({
+   "i": 1 /*one*/,
+   "j": 2 // two
+   // three
+})");
+   };
+   
+   "minify"_test = [] {
+      std::string buffer = R"({
+   "i" : 287, /* comment */
+   "hello": "Hello \" World  ", // another
+   "arr": [ 1, 2,
+            3 ]
+})";
+      expect(glz::minify(buffer) == R"({"i":287,"hello":"Hello \" World  ","arr":[1,2,3]})");
+      
+      std::string long_string(1000, 'x');
+      const auto json = "[ \"" + long_string + "\" , \"" + long_string + "\" ]";
+      expect(glz::minify(json) == "[\"" + long_string + "\",\"" + long_string + "\"]");
+   };
+   
+   "prettify minify round trip"_test = [] {
+      my_struct s{};
+      std::string buffer{};
+      glz::write_json(s, buffer);
+      expect(glz::minify(glz::prettify(buffer)) == buffer);
+   };
+};
+
 suite escaping_tests = [] {
    "escaped_key"_test = [] {
       std::string out;
@@ -1806,6 +1859,29 @@ void study_tests()
       
       expect(results == results2);
    };
+   
+   "study over states"_test = [] {
+      std::vector<int> states(64);
+      std::iota(states.begin(), states.end(), 0);
+      
+      // each state gets its own copy of the callable, so its members are not shared between workers
+      std::vector<int> seen(states.size());
+      glz::study::run_study(states, [&seen, calls = 0](const int state, const size_t i) mutable {
+         ++calls;
+         seen[i] = state + calls;
+      });
+      for (size_t i = 0; i < states.size(); ++i) {
+         expect(seen[i] == states[i] + 1);
+      }
+      
+      expect(throws([&] {
+         glz::study::run_study(states, [](const int state, const size_t) {
+            if (state == 7) {
+               throw std::runtime_error("study failed");
+            }
+         });
+      }));
+   };
 }
 
 suite progress_bar_tests = [] {
@@ -1989,6 +2065,245 @@ suite macro_tests = [] {
    };
 };
 
+suite thread_pool_tests = [] {
+   "pool results and exceptions"_test = [] {
+      glz::pool pool{4};
+      auto sum = pool.emplace_back([](const size_t) { return 40 + 2; });
+      auto fails = pool.emplace_back([](const size_t) -> int { throw std::runtime_error("task"); });
+      expect(sum.get() == 42);
+      expect(throws([&] { fails.get(); }));
+      
+      // tasks submitted from inside tasks run before wait returns
+      std::atomic<size_t> count{};
+      for (size_t i = 0; i < 16; ++i) {
+         pool.emplace_back([&](const size_t) {
+            for (size_t j = 0; j < 100; ++j) {
+               pool.emplace_back([&](const size_t thread_number) {
+                  expect(thread_number < pool.size());
+                  count.fetch_add(1, std::memory_order_relaxed);
+               });
+            }
+         });
+      }
+      pool.wait();
+      expect(count == 1600);
+      expect(!pool.computing());
+      
+      pool.n_threads(2);
+      expect(pool.size() == 2);
+      expect(pool.emplace_back([](const size_t) { return 1; }).get() == 1);
+   };
+   
+   "pool task handles"_test = [] {
+      glz::pool pool{4};
+      // move only and larger than a slot, the result and the callable go to the heap
+      auto ptr = pool.emplace_back([](const size_t) { return std::make_unique<int>(7); });
+      std::array<char, 1024> big_capture{};
+      big_capture[1023] = 'x';
+      auto big = pool.emplace_back([big_capture](const size_t) {
+         auto copy = big_capture;
+         copy[0] = 'a';
+         return copy;
+      });
+      auto text = pool.emplace_back([](const size_t) { return std::string(100, 'z'); });
+      auto nothing = pool.emplace_back([](const size_t) {});
+      expect(*ptr.get() == 7);
+      expect(!ptr.valid());
+      const auto copy = big.get();
+      expect(copy[0] == 'a' && copy[1023] == 'x');
+      expect(text.get() == std::string(100, 'z'));
+      nothing.wait();
+      expect(nothing.ready());
+      nothing.get();
+      expect(throws([&] { nothing.wait(); }));
+      
+      // handles dropped before or after their task finished, and many held at once
+      std::atomic<size_t> count{};
+      for (size_t i = 0; i < 1000; ++i) {
+         pool.emplace_back([&, s = std::string(50, 'y')](const size_t) { count.fetch_add(s.size()); });
+      }
+      std::vector<glz::task_handle<size_t>> handles{};
+      for (size_t i = 0; i < 10'000; ++i) {
+         handles.emplace_back(pool.emplace_back([i](const size_t) { return i; }));
+      }
+      size_t sum{};
+      for (auto& h : handles) {
+         sum += h.get();
+      }
+      pool.wait();
+      expect(count == 50'000);
+      expect(sum == 10'000 * 9'999 / 2);
+      
+      // submit and get in turn, so every task pays the full round trip of its handle
+      constexpr size_t n = 20'000;
+      auto t0 = std::chrono::steady_clock::now();
+      size_t total{};
+      for (size_t i = 0; i < n; ++i) {
+         total += pool.emplace_back([i](const size_t) { return i; }).get();
+      }
+      auto t1 = std::chrono::steady_clock::now();
+      expect(total == n * (n - 1) / 2);
+      std::cout << "pool task handles: " << std::chrono::duration<double, std::micro>(t1 - t0).count() / n
+                << " us per submit and get\n";
+   };
+   
+   "pool parallel_for and bulk"_test = [] {
+      glz::pool pool{4};
+      for (const size_t grain : {0, 1, 7, 1000, 5000}) {
+         std::vector<int> hits(3000);
+         pool.parallel_for(100, 3000, grain, [&](const size_t i) { ++hits[i]; });
+         expect(std::all_of(hits.begin(), hits.begin() + 100, [](int h) { return h == 0; }));
+         expect(std::all_of(hits.begin() + 100, hits.end(), [](int h) { return h == 1; }));
+      }
+      
+      expect(throws([&] {
+         pool.parallel_for(0, 100, 1, [](const size_t i) {
+            if (i == 57) throw std::runtime_error("range");
+         });
+      }));
+      
+      // nested inside a task, the worker helps instead of blocking
+      std::atomic<size_t> sum{};
+      pool.parallel_for(0, 8, 1, [&](const size_t) {
+         pool.parallel_for(0, 100, 0, [&](const size_t j) { sum.fetch_add(j, std::memory_order_relaxed); });
+      });
+      expect(sum == 8 * 4950);
+      
+      std::vector<size_t> bulk(1000);
+      pool.emplace_bulk(bulk.size(), [&](const size_t i, const size_t) { bulk[i] = i * 2; });
+      pool.wait();
+      expect(bulk[999] == 1998);
+   };
+   
+   "pool task throughput"_test = [] {
+      // tiny tasks, submitted from outside the pool and from inside its workers
+      constexpr size_t n = 100'000;
+      for (const size_t threads : {1, 2, 4, 8, 16, 32, 64}) {
+         glz::pool pool{threads};
+         std::atomic<size_t> count{};
+         
+         auto t0 = std::chrono::steady_clock::now();
+         for (size_t i = 0; i < n; ++i) {
+            pool.emplace_back([&](const size_t) { count.fetch_add(1, std::memory_order_relaxed); });
+         }
+         pool.wait();
+         auto t1 = std::chrono::steady_clock::now();
+         const auto external = n / std::chrono::duration<double>(t1 - t0).count();
+         
+         t0 = std::chrono::steady_clock::now();
+         constexpr size_t roots = 100;
+         for (size_t i = 0; i < roots; ++i) {
+            pool.emplace_back([&](const size_t) {
+               for (size_t j = 0; j < n / roots; ++j) {
+                  pool.emplace_back([&](const size_t) { count.fetch_add(1, std::memory_order_relaxed); });
+               }
+            });
+         }
+         pool.wait();
+         t1 = std::chrono::steady_clock::now();
+         const auto nested = (n + roots) / std::chrono::duration<double>(t1 - t0).count();
+         
+         t0 = std::chrono::steady_clock::now();
+         pool.emplace_bulk(n, [&](const size_t, const size_t) { count.fetch_add(1, std::memory_order_relaxed); });
+         pool.wait();
+         t1 = std::chrono::steady_clock::now();
+         const auto bulk = n / std::chrono::duration<double>(t1 - t0).count();
+         
+         t0 = std::chrono::steady_clock::now();
+         pool.parallel_for(0, n, 1, [&](const size_t) { count.fetch_add(1, std::memory_order_relaxed); });
+         t1 = std::chrono::steady_clock::now();
+         const auto ranges = n / std::chrono::duration<double>(t1 - t0).count();
+         
+         expect(count == 4 * n);
+         std::cout << "pool, " << threads << " threads: " << external / 1e6 << " M tasks/s submitted externally, "
+                   << nested / 1e6 << " M tasks/s submitted by tasks, " << bulk / 1e6 << " M tasks/s in bulk, "
+                   << ranges / 1e6 << " M indices/s with parallel_for\n";
+      }
+   };
+};
+
+suite parallel_write_tests = [] {
+   "parallel array write"_test = [] {
+      std::vector<macro_t> v(20000);
+      for (size_t i = 0; i < v.size(); ++i) {
+         v[i].x = static_cast<double>(i) * 0.5;
+         v[i].z = static_cast<int>(i);
+      }
+      
+      glz::pool pool{4};
+      glz::context ctx{};
+      ctx.thread_pool = &pool;
+      
+      std::string serial{};
+      glz::write_json(v, serial);
+      std::string parallel{};
+      glz::write<glz::opts{.parallel = true}>(v, parallel, ctx);
+      expect(parallel == serial);
+   };
+   
+   "parallel map write"_test = [] {
+      std::map<std::string, std::optional<int>> m;
+      for (int i = 0; i < 10000; ++i) {
+         if (i % 3) {
+            m[std::to_string(i)] = i;
+         }
+         else {
+            m[std::to_string(i)] = std::nullopt;
+         }
+      }
+      
+      glz::pool pool{4};
+      glz::context ctx{};
+      ctx.thread_pool = &pool;
+      ctx.parallel_threshold = 100;
+      
+      std::string serial{};
+      glz::write_json(m, serial);
+      std::string parallel{};
+      glz::write<glz::opts{.parallel = true}>(m, parallel, ctx);
+      expect(parallel == serial);
+   };
+};
+
+struct encoded_members_t
+{
+   std::vector<uint32_t> counts{1, 2, 3};
+   std::vector<int64_t> times{10, 20, 30};
+};
+
+template <>
+struct glz::meta<encoded_members_t>
+{
+   using T = encoded_members_t;
+   static constexpr auto value = object("counts", glz::varint<&T::counts>, "times", glz::delta<&T::times>);
+};
+
+suite encoded_member_tests = [] {
+   "encoded members are plain json"_test = [] {
+      encoded_members_t obj{};
+      std::string s{};
+      glz::write_json(obj, s);
+      expect(s == R"({"counts":[1,2,3],"times":[10,20,30]})");
+      
+      glz::read_json(obj, R"({"counts":[4],"times":[5,6]})");
+      expect(obj.counts == std::vector<uint32_t>{4});
+      expect(obj.times == std::vector<int64_t>{5, 6});
+   };
+};
+
+suite serialized_size_tests = [] {
+   "json serialized size"_test = [] {
+      Thing obj{};
+      const auto s = glz::write_json(obj);
+      expect(glz::serialized_size<glz::opts{}>(obj) == s.size());
+      
+      // outputs larger than the retained scratch space are measured the same way
+      std::vector<std::string> large(2000, std::string(100, 'x'));
+      expect(glz::serialized_size<glz::opts{}>(large) == glz::write_json(large).size());
+      expect(glz::serialized_size<glz::opts{}>(obj) == s.size());
+   };
+};
+
 struct includer_struct
 {
    std::string str = "Hello";